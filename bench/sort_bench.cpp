@@ -0,0 +1,65 @@
+/**
+ * @file sort_bench.cpp
+ *
+ * @brief Measures the weak scaling of mpi::sort.
+ * @date 2026-10-16
+ *
+ * @details
+ * Every process sorts the same number of random 64-bit keys, so with perfect scaling the time stays
+ * flat as processes are added. Run with increasing process counts, e.g.
+ *
+ *     mpirun -np 1024 mpi-cpp-sort-bench 1000000 5
+ *
+ * The arguments are the number of keys per process, and the number of repetitions.
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+#include <mpi/mpi.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+int main(int argc, char **argv) {
+    mpi::init(argc, argv);
+    {
+        auto world = mpi::Comm::world();
+
+        std::size_t const keys = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+        int const repetitions = argc > 2 ? std::atoi(argv[2]) : 5;
+
+        std::mt19937_64 rng(world.rank());
+        std::vector<std::uint64_t> data;
+
+        double best = 0;
+        for (int repetition = 0; repetition < repetitions; repetition++) {
+            data.resize(keys);
+            for (auto &key : data) {
+                key = rng();
+            }
+
+            world.barrier();
+            auto const start = mpi::MpiClock::now();
+            mpi::sort(world, data);
+            std::chrono::duration<double> const local = mpi::MpiClock::now() - start;
+
+            auto const elapsed = world.all_reduce(mpi::max(), local.count());
+            if (repetition == 0 || elapsed < best) {
+                best = elapsed;
+            }
+        }
+
+        std::size_t const largest = world.all_reduce(mpi::max(), std::uint64_t(data.size()));
+        if (world.rank() == 0) {
+            auto const total = static_cast<double>(keys) * world.size();
+            std::cout << "ranks " << world.size() << "  keys/rank " << keys << "  time " << best
+                      << " s  rate " << total / best / 1e6 << " Mkeys/s  imbalance "
+                      << static_cast<double>(largest) / keys << std::endl;
+        }
+    }
+    mpi::finalize();
+}
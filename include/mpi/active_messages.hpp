@@ -0,0 +1,272 @@
+/**
+ * @file active_messages.hpp
+ *
+ * @brief Defines an active-message layer for invoking typed handlers on remote processes.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+#ifndef MPI_ACTIVE_MESSAGES_HPP
+#define MPI_ACTIVE_MESSAGES_HPP
+
+#include "mpi_stub_out.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <nonstd/span.hpp>
+
+#include "aggregator.hpp"
+#include "comm.hpp"
+#include "deref.hpp"
+
+namespace mpi {
+namespace internal {
+template <typename... Ts>
+struct SizeSum;
+
+template <>
+struct SizeSum<> {
+    static constexpr std::size_t value = 0;
+};
+
+template <typename T, typename... Ts>
+struct SizeSum<T, Ts...> {
+    static constexpr std::size_t value = sizeof(T) + SizeSum<Ts...>::value;
+};
+
+template <typename... Ts>
+struct AllTriviallyCopyable;
+
+template <>
+struct AllTriviallyCopyable<> : std::true_type {};
+
+template <typename T, typename... Ts>
+struct AllTriviallyCopyable<T, Ts...>
+    : std::integral_constant<bool,
+                             std::is_trivially_copyable<T>::value &&
+                                 AllTriviallyCopyable<Ts...>::value> {};
+
+/**
+ * @brief Extracts the arguments an active-message handler takes after the source rank.
+ */
+template <typename Signature>
+struct HandlerSignature;
+
+template <typename C, typename R, typename... Args>
+struct HandlerSignature<R (C::*)(rank_t, Args...)> {
+    using args_t = std::tuple<std::decay_t<Args>...>;
+};
+
+template <typename C, typename R, typename... Args>
+struct HandlerSignature<R (C::*)(rank_t, Args...) const>
+    : HandlerSignature<R (C::*)(rank_t, Args...)> {};
+
+template <typename Handler>
+using handler_args_t = typename HandlerSignature<decltype(&Handler::operator())>::args_t;
+
+template <typename T>
+T read_unaligned(char const *&data) {
+    std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+    std::memcpy(&storage, data, sizeof(T));
+    data += sizeof(T);
+    return *reinterpret_cast<T const *>(&storage);
+}
+
+template <typename T>
+void write_unaligned(char *&data, T const &value) {
+    std::memcpy(data, &value, sizeof(T));
+    data += sizeof(T);
+}
+} // namespace internal
+
+/**
+ * @brief Invokes registered handlers on remote processes, batching the invocations per
+ *  destination.
+ *
+ * @details
+ * A handler is a function object whose `operator()` takes the source rank followed by any number
+ * of trivially copyable arguments. Each handler type is registered once, and is assigned a compact
+ * id in registration order, so every process must register the same handlers in the same order.
+ * `send_am<Handler>(dest, args...)` packs the handler id and arguments into the aggregation buffer
+ * for `dest`, and `progress()` or `drain()` on `dest` invokes the handler.
+ *
+ * Handlers run on the thread calling `progress()` or `drain()`, and may send further active
+ * messages, any number of them and to any destination, including while draining. A handler that
+ * needs state, such as the ActiveMessages to send with, carries it as members and is registered
+ * with `register_handler(Handler{...})`.
+ *
+ * Construction and `drain` are collective over the communicator.
+ */
+class ActiveMessages {
+  public:
+    using handler_id_t = std::uint16_t;
+
+    /**
+     * @brief Creates the active-message layer. Collective over `comm`.
+     *
+     * @param comm The communicator to send over
+     * @param batch_bytes The number of bytes buffered for a destination before they are sent
+     */
+    template <typename From>
+    explicit ActiveMessages(trait::Deref<From, Comm> const &comm,
+                            std::size_t batch_bytes = 64 * 1024)
+        : aggregator_(comm, batch_bytes, [this](rank_t source, nonstd::span<char const> batch) {
+              dispatch(source, batch);
+          }) {}
+
+    /**
+     * @brief Registers a handler, assigning it the next handler id.
+     *
+     * @throws std::logic_error if `Handler` is already registered
+     */
+    template <typename Handler>
+    handler_id_t register_handler(Handler handler = Handler{}) {
+        using args_t = internal::handler_args_t<Handler>;
+        static_assert(IsSendable<args_t>::value,
+                      "active-message arguments are sent as bytes, so must be trivially copyable");
+
+        if (dispatchers_.size() > std::numeric_limits<handler_id_t>::max()) {
+            throw std::out_of_range("too many active-message handlers");
+        }
+
+        auto const id = static_cast<handler_id_t>(dispatchers_.size());
+        if (!ids_.emplace(std::type_index(typeid(Handler)), id).second) {
+            throw std::logic_error("active-message handler is already registered");
+        }
+
+        dispatchers_.push_back([handler](rank_t source, char const *&data) mutable {
+            Invoke<args_t>::invoke(handler, source, data);
+        });
+        return id;
+    }
+
+    /**
+     * @brief Queues an invocation of `Handler` on `dest`.
+     *
+     * @param args Converted to the argument types of the handler
+     * @throws std::logic_error if `Handler` has not been registered
+     */
+    template <typename Handler, typename... Args>
+    void send_am(rank_t dest, Args &&... args) {
+        using args_t = internal::handler_args_t<Handler>;
+        static_assert(std::tuple_size<args_t>::value == sizeof...(Args),
+                      "wrong number of arguments for the active-message handler");
+
+        Pack<args_t>::append(aggregator_, dest, id_of<Handler>(), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Sends every partially filled batch.
+     */
+    void flush() { aggregator_.flush(); }
+
+    /**
+     * @brief Runs the handlers for any messages that have arrived, without blocking.
+     *
+     * @return The number of handlers run.
+     */
+    std::size_t progress() {
+        auto const before = dispatched_;
+        aggregator_.progress();
+        return dispatched_ - before;
+    }
+
+    /**
+     * @brief Sends every queued message, and runs handlers until all messages sent by any process
+     *  have been handled, including those sent by handlers. Collective over the communicator.
+     */
+    void drain() { aggregator_.drain(); }
+
+  private:
+    using dispatcher_t = std::function<void(rank_t source, char const *&data)>;
+
+    template <typename Tuple>
+    struct IsSendable;
+
+    template <typename... Ts>
+    struct IsSendable<std::tuple<Ts...>> : internal::AllTriviallyCopyable<Ts...> {};
+
+    template <typename Tuple>
+    struct Invoke;
+
+    template <typename... Ts>
+    struct Invoke<std::tuple<Ts...>> {
+        template <typename Handler>
+        static void invoke(Handler &handler, rank_t source, char const *&data) {
+            // Braced initialization reads the arguments in order.
+            std::tuple<Ts...> args{internal::read_unaligned<Ts>(data)...};
+            call(handler, source, args, std::index_sequence_for<Ts...>{});
+        }
+
+        template <typename Handler, std::size_t... Is>
+        static void
+        call(Handler &handler, rank_t source, std::tuple<Ts...> &args, std::index_sequence<Is...>) {
+            handler(source, std::get<Is>(args)...);
+        }
+    };
+
+    template <typename Tuple>
+    struct Pack;
+
+    template <typename... Ts>
+    struct Pack<std::tuple<Ts...>> {
+        template <typename... Args>
+        static void append(internal::MessageAggregator &aggregator,
+                           rank_t dest,
+                           handler_id_t id,
+                           Args &&... args) {
+            std::array<char, sizeof(handler_id_t) + internal::SizeSum<Ts...>::value> message;
+            char *data = message.data();
+            internal::write_unaligned(data, id);
+            (void)std::initializer_list<int>{
+                (internal::write_unaligned(data, Ts(std::forward<Args>(args))), 0)...};
+            aggregator.append(dest, message.data(), message.size());
+        }
+    };
+
+    template <typename Handler>
+    handler_id_t id_of() const {
+        auto const it = ids_.find(std::type_index(typeid(Handler)));
+        if (it == ids_.end()) {
+            throw std::logic_error("active-message handler has not been registered");
+        }
+        return it->second;
+    }
+
+    void dispatch(rank_t source, nonstd::span<char const> batch) {
+        char const *data = batch.data();
+        char const *const end = data + batch.size();
+        while (data < end) {
+            auto const id = internal::read_unaligned<handler_id_t>(data);
+            if (id >= dispatchers_.size()) {
+                throw std::logic_error("received an active message for an unknown handler");
+            }
+
+            dispatchers_[id](source, data);
+            dispatched_++;
+        }
+    }
+
+    std::unordered_map<std::type_index, handler_id_t> ids_;
+    std::vector<dispatcher_t> dispatchers_;
+    std::size_t dispatched_ = 0;
+
+    internal::MessageAggregator aggregator_;
+};
+} // namespace mpi
+
+#endif // MPI_ACTIVE_MESSAGES_HPP
@@ -0,0 +1,402 @@
+/**
+ * @file aggregator.hpp
+ *
+ * @brief Defines a layer that batches many small point-to-point messages into fewer large ones.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+#ifndef MPI_AGGREGATOR_HPP
+#define MPI_AGGREGATOR_HPP
+
+#include "mpi_stub_out.h"
+
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <nonstd/span.hpp>
+
+#include "comm.hpp"
+#include "deref.hpp"
+#include "exception.hpp"
+#include "op.hpp"
+#include "request.hpp"
+
+namespace mpi {
+namespace internal {
+/**
+ * @brief Batches byte payloads by destination, and delivers received batches to a handler.
+ *
+ * @details
+ * Each destination has two buffers: one being filled by `append`, and one being sent. A full
+ * buffer is only swapped out once the previous send to that destination has completed, so
+ * packing new payloads overlaps the transfer of earlier ones. Batches are sent with MPI_Issend,
+ * which lets `drain` detect global completion with the nonblocking consensus algorithm.
+ *
+ * Batches are received into an inbox as soon as they are probed, including while waiting for a
+ * send to complete, so two processes flushing to each other cannot deadlock. The inbox is only
+ * handed to the handler by `progress` and `drain`, never from inside `append`.
+ *
+ * Once `drain` has posted its barrier, peers may already be waiting in the closing reduction and
+ * will not receive again until the next round, so nothing waits for a send to complete: a batch
+ * is only sent if the previous send to its destination has finished, and otherwise stays in the
+ * buffer for the next round.
+ */
+class MessageAggregator {
+  public:
+    using handler_t = std::function<void(rank_t source, nonstd::span<char const> batch)>;
+
+    /**
+     * @brief Creates an aggregator. Collective over `comm`, which is duplicated so that batches
+     *  cannot match other traffic.
+     *
+     * @param comm The communicator to send over
+     * @param threshold A destination's buffer is sent once it holds at least this many bytes
+     * @param handler Called with the source and contents of each received batch
+     */
+    template <typename From>
+    MessageAggregator(trait::Deref<From, Comm> const &comm,
+                      std::size_t threshold,
+                      handler_t handler)
+        : comm_(comm.deref().dup()),
+          threshold_(threshold),
+          handler_(std::move(handler)),
+          outboxes_(comm_.size()) {
+        if (threshold_ == 0 ||
+            threshold_ > static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+            throw std::out_of_range("aggregation threshold must be positive and fit in an int");
+        }
+    }
+
+    MessageAggregator(MessageAggregator const &) = delete;
+    MessageAggregator &operator=(MessageAggregator const &) = delete;
+
+    /**
+     * @brief Waits for batches that are still being sent. Call `drain` first, otherwise the
+     *  receivers may never match them.
+     */
+    ~MessageAggregator() {
+        for (auto &outbox : outboxes_) {
+            if (outbox.request) {
+                outbox.request.wait();
+            }
+        }
+    }
+
+    Comm comm() const { return comm_.deref(); }
+
+    /**
+     * @brief Appends a payload to the buffer for `dest`, sending the buffer if it is full.
+     */
+    void append(rank_t dest, void const *data, std::size_t size) {
+        auto &filling = outboxes_.at(dest).filling;
+        auto const *const bytes = static_cast<char const *>(data);
+        filling.insert(filling.end(), bytes, bytes + size);
+
+        if (filling.size() >= threshold_) {
+            flush(dest);
+        }
+    }
+
+    /**
+     * @brief Sends the buffer for `dest` if it is not empty, first waiting for the previous batch
+     *  to `dest` to be sent. Called from a handler after `drain` has posted its barrier, it does
+     *  not wait, and leaves the buffer for the next round if the previous batch is still in
+     *  flight.
+     */
+    void flush(rank_t dest) {
+        auto &outbox = outboxes_.at(dest);
+        if (outbox.filling.empty()) {
+            return;
+        }
+
+        if (barrier_posted_) {
+            try_flush(dest);
+            return;
+        }
+
+        while (!outbox.request.test()) {
+            receive();
+        }
+
+        send(dest);
+    }
+
+    /**
+     * @brief Sends every non-empty buffer.
+     */
+    void flush() {
+        for (rank_t dest = 0; dest < static_cast<rank_t>(outboxes_.size()); dest++) {
+            flush(dest);
+        }
+    }
+
+    /**
+     * @brief Receives any available batches and hands them to the handler, without blocking.
+     *
+     * @return The number of batches handled.
+     */
+    std::size_t progress() {
+        receive();
+        return deliver();
+    }
+
+    /**
+     * @brief Sends every buffer, and handles batches until every batch sent by any process has
+     *  been handled. Collective over the communicator.
+     *
+     * @details
+     * Handlers may append more payloads while draining. Those are flushed too, and the drain
+     * repeats until a round completes in which no process appended anything.
+     */
+    void drain() {
+        int appended;
+        do {
+            appended = 0;
+            flush();
+
+            std::size_t sent_before_barrier = 0;
+            UniqueRequest barrier;
+            while (true) {
+                progress();
+
+                if (barrier) {
+                    // Peers may already have left this round, so anything sent since the barrier
+                    // was posted - or still waiting for an earlier send to finish - is delivered
+                    // by the next round.
+                    for (rank_t dest = 0; dest < static_cast<rank_t>(outboxes_.size()); dest++) {
+                        try_flush(dest);
+                    }
+                    if (has_unsent() || batches_sent_ != sent_before_barrier) {
+                        appended = 1;
+                    }
+
+                    if (barrier.test()) {
+                        break;
+                    }
+                } else if (has_unsent()) {
+                    flush();
+                } else if (all_sent()) {
+                    sent_before_barrier = batches_sent_;
+                    barrier = comm_.immediate_barrier();
+                    barrier_posted_ = true;
+                }
+            }
+            barrier_posted_ = false;
+        } while (comm_.all_reduce(logical_or(), appended));
+    }
+
+  private:
+    // Batches travel on a private duplicate of the communicator, so no other traffic can use it.
+    static constexpr tag_t tag = 0;
+
+    struct Outbox {
+        std::vector<char> filling;
+        std::vector<char> sending;
+        UniqueRequest request;
+    };
+
+    struct Batch {
+        rank_t source;
+        std::vector<char> bytes;
+    };
+
+    /**
+     * @brief Sends the buffer for `dest` if it is not empty and the previous batch to `dest` has
+     *  been sent, without waiting.
+     */
+    void try_flush(rank_t dest) {
+        auto &outbox = outboxes_[dest];
+        if (!outbox.filling.empty() && outbox.request.test()) {
+            send(dest);
+        }
+    }
+
+    void send(rank_t dest) {
+        auto &outbox = outboxes_[dest];
+        if (outbox.filling.size() > static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+            throw std::out_of_range("aggregated batch is too large");
+        }
+
+        std::swap(outbox.filling, outbox.sending);
+        outbox.filling.clear();
+
+        check_result(MPI_Issend(outbox.sending.data(),
+                                static_cast<int>(outbox.sending.size()),
+                                MPI_BYTE,
+                                dest,
+                                tag,
+                                comm_.comm(),
+                                outbox.request.addressof()));
+        batches_sent_++;
+    }
+
+    void receive() {
+        while (true) {
+            int flag;
+            MPI_Message message;
+            MPI_Status status;
+            check_result(MPI_Improbe(MPI_ANY_SOURCE, tag, comm_.comm(), &flag, &message, &status));
+            if (!flag) {
+                return;
+            }
+
+            int count;
+            check_result(MPI_Get_count(&status, MPI_BYTE, &count));
+
+            Batch batch{status.MPI_SOURCE, {}};
+            if (!spare_.empty()) {
+                batch.bytes = std::move(spare_.back());
+                spare_.pop_back();
+            }
+            batch.bytes.resize(count);
+
+            check_result(
+                MPI_Mrecv(batch.bytes.data(), count, MPI_BYTE, &message, MPI_STATUS_IGNORE));
+            inbox_.push_back(std::move(batch));
+        }
+    }
+
+    std::size_t deliver() {
+        // A handler that calls `progress` only receives; the outer call keeps delivering in order.
+        if (delivering_) {
+            return 0;
+        }
+
+        delivering_ = true;
+        std::size_t delivered = 0;
+        try {
+            while (!inbox_.empty()) {
+                auto batch = std::move(inbox_.front());
+                inbox_.pop_front();
+
+                handler_(batch.source, batch.bytes);
+                delivered++;
+
+                spare_.push_back(std::move(batch.bytes));
+            }
+        } catch (...) {
+            delivering_ = false;
+            throw;
+        }
+        delivering_ = false;
+        return delivered;
+    }
+
+    bool has_unsent() const {
+        for (auto const &outbox : outboxes_) {
+            if (!outbox.filling.empty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool all_sent() {
+        for (auto &outbox : outboxes_) {
+            if (!outbox.request.test()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    UniqueComm comm_;
+    std::size_t threshold_;
+    handler_t handler_;
+
+    std::vector<Outbox> outboxes_;
+    std::deque<Batch> inbox_;
+    std::vector<std::vector<char>> spare_;
+    std::size_t batches_sent_ = 0;
+    bool barrier_posted_ = false;
+    bool delivering_ = false;
+};
+} // namespace internal
+
+/**
+ * @brief Aggregates many small messages of type `T` into large batches per destination.
+ *
+ * @details
+ * `send` only copies an item into the buffer for its destination; the buffer is sent once it is
+ * full, or on `flush`. Received items are handed to the handler one at a time by `progress` and
+ * `drain`, on the calling thread. `T` is sent as raw bytes, so it must be trivially copyable.
+ *
+ * A typical step sends items while calling `progress` periodically, then calls `drain` to
+ * deliver everything still in flight.
+ *
+ * Construction and `drain` are collective over the communicator.
+ */
+template <typename T>
+class Aggregator {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Aggregator items are sent as bytes, so they must be trivially copyable");
+
+  public:
+    using handler_t = std::function<void(rank_t source, T const &item)>;
+
+    /**
+     * @brief Creates an aggregator. Collective over `comm`.
+     *
+     * @param comm The communicator to send over
+     * @param handler Called for every received item
+     * @param batch_size The number of items buffered for a destination before they are sent
+     */
+    template <typename From>
+    Aggregator(trait::Deref<From, Comm> const &comm,
+               handler_t handler,
+               std::size_t batch_size = 1024)
+        : handler_(std::move(handler)),
+          aggregator_(comm,
+                      batch_size * sizeof(T),
+                      [this](rank_t source, nonstd::span<char const> batch) {
+                          unpack(source, batch);
+                      }) {}
+
+    /**
+     * @brief Queues `item` for delivery to `dest`.
+     */
+    void send(rank_t dest, T const &item) { aggregator_.append(dest, &item, sizeof(T)); }
+
+    /**
+     * @brief Sends every partially filled batch.
+     */
+    void flush() { aggregator_.flush(); }
+
+    /**
+     * @brief Handles any items that have arrived, without blocking.
+     *
+     * @return The number of batches handled.
+     */
+    std::size_t progress() { return aggregator_.progress(); }
+
+    /**
+     * @brief Sends every queued item, and handles items until all items sent by any process have
+     *  been handled. Collective over the communicator.
+     */
+    void drain() { aggregator_.drain(); }
+
+  private:
+    void unpack(rank_t source, nonstd::span<char const> batch) {
+        for (std::size_t offset = 0; offset + sizeof(T) <= batch.size(); offset += sizeof(T)) {
+            // Items in a batch are not necessarily aligned, so copy each one out first.
+            std::aligned_storage_t<sizeof(T), alignof(T)> item;
+            std::memcpy(&item, batch.data() + offset, sizeof(T));
+            handler_(source, *reinterpret_cast<T const *>(&item));
+        }
+    }
+
+    handler_t handler_;
+    internal::MessageAggregator aggregator_;
+};
+} // namespace mpi
+
+#endif // MPI_AGGREGATOR_HPP
@@ -0,0 +1,401 @@
+/**
+ * @file algorithm.hpp
+ *
+ * @brief Defines parallel algorithms over data distributed across a communicator.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+#ifndef MPI_ALGORITHM_HPP
+#define MPI_ALGORITHM_HPP
+
+#include "mpi_stub_out.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <nonstd/span.hpp>
+
+#include "buffer.hpp"
+#include "comm.hpp"
+#include "datatype.hpp"
+#include "deref.hpp"
+#include "op.hpp"
+
+namespace mpi {
+namespace internal {
+/**
+ * @brief Merges the consecutive sorted runs of `data`, whose sizes are `counts`, pairwise in
+ *  log2(runs) passes.
+ */
+template <typename T, typename Compare>
+void merge_runs(std::vector<T> &data, std::vector<int> const &counts, Compare comp) {
+    std::vector<std::size_t> bounds{0};
+    for (auto const count : counts) {
+        bounds.push_back(bounds.back() + count);
+    }
+
+    while (bounds.size() > 2) {
+        std::vector<std::size_t> merged{0};
+        for (std::size_t i = 0; i + 2 < bounds.size(); i += 2) {
+            std::inplace_merge(data.begin() + bounds[i],
+                               data.begin() + bounds[i + 1],
+                               data.begin() + bounds[i + 2],
+                               comp);
+            merged.push_back(bounds[i + 2]);
+        }
+        if (bounds.size() % 2 == 0) {
+            merged.push_back(bounds.back());
+        }
+        bounds = std::move(merged);
+    }
+}
+
+/**
+ * @brief Adds the values of `data` within `[lo, hi)` to `bins` uniform bins.
+ *
+ * @details
+ * Bin indices are computed a chunk at a time in a branch-free loop, which compilers vectorize;
+ * values out of range, and NaNs, are sent to an overflow slot rather than branched around. The
+ * counts are then scattered over several interleaved sub-histograms, so runs of equal bins do not
+ * serialize on a single counter.
+ */
+template <typename T>
+std::vector<std::uint64_t> bin_values(nonstd::span<T const> data, std::size_t bins, T lo, T hi) {
+    constexpr std::size_t chunk = 256;
+    constexpr std::size_t lanes = 4;
+
+    auto const stride = bins + 1;
+    auto const scale = bins / (static_cast<double>(hi) - static_cast<double>(lo));
+    auto const last = static_cast<double>(bins - 1);
+    auto const overflow = static_cast<double>(bins);
+
+    std::vector<std::uint64_t> counts(lanes * stride);
+    std::uint32_t index[chunk];
+    for (std::size_t start = 0; start < data.size(); start += chunk) {
+        auto const n = std::min(chunk, data.size() - start);
+        auto const *const values = data.data() + start;
+
+        for (std::size_t i = 0; i < n; i++) {
+            // `&` rather than `&&`, which would be a branch and stop the loop vectorizing.
+            auto const in_range = (values[i] >= lo) & (values[i] < hi);
+            auto const bin = std::min((static_cast<double>(values[i]) - lo) * scale, last);
+            index[i] = static_cast<std::uint32_t>(in_range ? bin : overflow);
+        }
+
+        for (std::size_t i = 0; i < n; i++) {
+            counts[(i % lanes) * stride + index[i]]++;
+        }
+    }
+
+    std::vector<std::uint64_t> histogram(bins);
+    for (std::size_t lane = 0; lane < lanes; lane++) {
+        for (std::size_t bin = 0; bin < bins; bin++) {
+            histogram[bin] += counts[lane * stride + bin];
+        }
+    }
+    return histogram;
+}
+
+/**
+ * @brief Packs the best `k` elements under `Compare` into a fixed-size record, and merges records
+ *  as a user-defined reduction.
+ *
+ * @details
+ * A record holds the number of elements it contains, followed by room for `k` elements, best
+ * first. `k` is recovered from the size of the datatype the op is applied to.
+ */
+template <typename T, typename Compare>
+struct TopK {
+    static std::size_t record_size(std::size_t k) { return sizeof(std::uint64_t) + k * sizeof(T); }
+
+    static std::vector<T> read(char const *record) {
+        std::uint64_t count;
+        std::memcpy(&count, record, sizeof(count));
+
+        std::vector<T> items(count);
+        std::memcpy(items.data(), record + sizeof(count), count * sizeof(T));
+        return items;
+    }
+
+    static void write(char *record, std::vector<T> const &items) {
+        std::uint64_t const count = items.size();
+        std::memcpy(record, &count, sizeof(count));
+        std::memcpy(record + sizeof(count), items.data(), count * sizeof(T));
+    }
+
+    static void merge(void *in, void *inout, int *len, MPI_Datatype *datatype) {
+        // Called by MPI, so errors cannot be thrown; a record type always has a size.
+        int bytes;
+        MPI_Type_size(*datatype, &bytes);
+        auto const k = (bytes - sizeof(std::uint64_t)) / sizeof(T);
+
+        Compare comp;
+        auto const better = [&](T const &a, T const &b) { return comp(b, a); };
+
+        for (int i = 0; i < *len; i++) {
+            auto *const target = static_cast<char *>(inout) + std::size_t(i) * bytes;
+            auto const a = read(static_cast<char const *>(in) + std::size_t(i) * bytes);
+            auto const b = read(target);
+
+            std::vector<T> merged(a.size() + b.size());
+            std::merge(a.begin(), a.end(), b.begin(), b.end(), merged.begin(), better);
+            merged.resize(std::min(merged.size(), k));
+            write(target, merged);
+        }
+    }
+};
+} // namespace internal
+
+/**
+ * @brief Sorts the elements of `data` across all processes of `comm`, using sample sort.
+ *
+ * @details
+ * Afterwards, each process' `data` is sorted, and every element on a process is ordered before
+ * (or equivalent to) every element on the processes ranked after it. The number of elements on
+ * each process generally changes; it is balanced up to the quality of the sampled splitters.
+ * Equivalent elements are told apart by the rank and position they start from, so a long run of
+ * equivalent elements (e.g. few distinct keys) is split between processes like any other.
+ *
+ * Each process sorts its elements, and contributes up to `oversampling` regularly spaced samples.
+ * The samples are gathered on rank 0, which chooses `comm.size() - 1` splitters and broadcasts
+ * them. Every process then sends the elements between consecutive splitters to the corresponding
+ * process with a single `all_to_all_v`, and merges the sorted runs it receives.
+ *
+ * Collective over `comm`.
+ *
+ * @param oversampling The number of samples each process contributes. More samples balance the
+ *  result better, at the cost of gathering and sorting `oversampling * comm.size()` samples on
+ *  rank 0.
+ */
+template <typename From, typename T, typename Compare = std::less<T>>
+void sort(trait::Deref<From, Comm> const &comm,
+          std::vector<T> &data,
+          Compare comp = Compare{},
+          int oversampling = 32) {
+    static_assert(is_datatype_v<T>, "sorted elements are exchanged, so must be MPI datatypes");
+
+    auto c = comm.deref();
+    std::sort(data.begin(), data.end(), comp);
+
+    rank_t const ranks = c.size();
+    if (ranks == 1) {
+        return;
+    }
+
+    if (oversampling < 1) {
+        throw std::out_of_range("at least one sample per process is required");
+    }
+    if (data.size() > static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+        throw std::out_of_range("too many elements to sort on one process");
+    }
+
+    // Samples carry their position, so that elements are ordered by (value, rank, position).
+    auto const sample_count = static_cast<int>(std::min<std::size_t>(oversampling, data.size()));
+    std::vector<T> samples(sample_count);
+    std::vector<std::uint64_t> positions(sample_count);
+    for (int i = 0; i < sample_count; i++) {
+        positions[i] = (2 * std::uint64_t(i) + 1) * data.size() / (2 * sample_count);
+        samples[i] = data[positions[i]];
+    }
+
+    std::vector<int> sample_counts;
+    auto const all_samples = c.gather_v(0, nonstd::span<T const>(samples), &sample_counts);
+    auto const all_positions = c.gather_v(0, nonstd::span<std::uint64_t const>(positions));
+
+    // Splitter s is (values[s], owners[2 s], owners[2 s + 1]), as (value, rank, position).
+    std::vector<T> values(ranks - 1);
+    std::vector<std::uint64_t> owners(2 * (std::size_t(ranks) - 1));
+    int found = 0;
+    if (c.rank() == 0 && !all_samples.empty()) {
+        std::vector<std::uint64_t> sample_ranks;
+        for (rank_t r = 0; r < ranks; r++) {
+            sample_ranks.insert(sample_ranks.end(), sample_counts[r], r);
+        }
+
+        std::vector<std::size_t> order(all_samples.size());
+        std::iota(order.begin(), order.end(), std::size_t(0));
+        std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+            if (comp(all_samples[a], all_samples[b])) {
+                return true;
+            }
+            if (comp(all_samples[b], all_samples[a])) {
+                return false;
+            }
+            return std::make_pair(sample_ranks[a], all_positions[a]) <
+                   std::make_pair(sample_ranks[b], all_positions[b]);
+        });
+
+        for (rank_t r = 0; r + 1 < ranks; r++) {
+            auto const chosen = order[(std::size_t(r) + 1) * order.size() / ranks];
+            values[r] = all_samples[chosen];
+            owners[2 * r] = sample_ranks[chosen];
+            owners[2 * r + 1] = all_positions[chosen];
+        }
+        found = 1;
+    }
+
+    if (!c.broadcast(0, found)) {
+        return;
+    }
+    c.broadcast(0, nonstd::span<T>(values));
+    c.broadcast(0, nonstd::span<std::uint64_t>(owners));
+
+    // Whether element i of this process is ordered at or before splitter s.
+    std::uint64_t const rank = c.rank();
+    auto const at_or_before = [&](std::size_t i, rank_t s) {
+        if (comp(data[i], values[s])) {
+            return true;
+        }
+        if (comp(values[s], data[i])) {
+            return false;
+        }
+        return std::make_pair(rank, std::uint64_t(i)) <=
+               std::make_pair(owners[2 * s], owners[2 * s + 1]);
+    };
+
+    // Process r receives the elements after splitter r - 1, up to and including splitter r.
+    std::vector<int> send_counts(ranks);
+    std::size_t begin = 0;
+    for (rank_t r = 0; r + 1 < ranks; r++) {
+        auto end = begin;
+        auto count = data.size() - begin;
+        while (count > 0) {
+            auto const step = count / 2;
+            if (at_or_before(end + step, r)) {
+                end += step + 1;
+                count -= step + 1;
+            } else {
+                count = step;
+            }
+        }
+        send_counts[r] = static_cast<int>(end - begin);
+        begin = end;
+    }
+    send_counts[ranks - 1] = static_cast<int>(data.size() - begin);
+
+    std::vector<int> recv_counts;
+    data = c.all_to_all_v(
+        nonstd::span<T const>(data), nonstd::span<int const>(send_counts), &recv_counts);
+    internal::merge_runs(data, recv_counts, comp);
+}
+
+/**
+ * @brief Counts the values of `data` on every process in `bins` uniform bins over `[lo, hi)`.
+ *
+ * @details
+ * Each process bins its own values, then the counts are summed with a single in-place
+ * `all_reduce`, so the traffic only depends on the number of bins. Values outside of `[lo, hi)`
+ * are not counted.
+ *
+ * Collective over `comm`.
+ *
+ * @return The global count of each bin, on every process.
+ */
+template <typename From, typename T>
+std::vector<std::uint64_t> distributed_histogram(trait::Deref<From, Comm> const &comm,
+                                                 nonstd::span<T const> data,
+                                                 std::size_t bins,
+                                                 T lo,
+                                                 T hi) {
+    static_assert(std::is_arithmetic<T>::value, "histogram values must be arithmetic");
+
+    if (bins == 0) {
+        throw std::out_of_range("histogram must have a positive number of bins");
+    }
+    if (bins >= std::numeric_limits<std::uint32_t>::max()) {
+        throw std::out_of_range("histogram has too many bins");
+    }
+    if (!(lo < hi)) {
+        throw std::out_of_range("histogram range must not be empty");
+    }
+
+    auto histogram = internal::bin_values(data, bins, lo, hi);
+    comm.deref().all_reduce_in_place(sum(), nonstd::span<std::uint64_t>(histogram));
+    return histogram;
+}
+
+template <typename From, typename T>
+std::vector<std::uint64_t> distributed_histogram(trait::Deref<From, Comm> const &comm,
+                                                 std::vector<T> const &data,
+                                                 std::size_t bins,
+                                                 T lo,
+                                                 T hi) {
+    return distributed_histogram(comm, nonstd::span<T const>(data), bins, lo, hi);
+}
+
+/**
+ * @brief Finds the `k` greatest elements under `comp` over the `data` of every process.
+ *
+ * @details
+ * Each process selects its own best `k`, and the selections are merged pairwise by a user-defined
+ * op in a single `all_reduce`, which MPI implementations carry out as a tree. Each step only
+ * passes on `k` elements, so the traffic is O(k log P), rather than the O(k P) of gathering every
+ * process' selection. Ties are broken arbitrarily.
+ *
+ * The op cannot carry state, so it uses a default-constructed `Compare`, which must order elements
+ * the same way as `comp`.
+ *
+ * Collective over `comm`.
+ *
+ * @return The best `k` elements, or fewer if there are not that many, best first, on every
+ *  process.
+ */
+template <typename From, typename T, typename Compare = std::less<T>>
+std::vector<T> distributed_top_k(trait::Deref<From, Comm> const &comm,
+                                 nonstd::span<T const> data,
+                                 std::size_t k,
+                                 Compare comp = Compare{}) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "top-k elements are reduced as bytes, so must be trivially copyable");
+    static_assert(std::is_default_constructible<Compare>::value,
+                  "the comparison is used inside an MPI op, so must be default constructible");
+
+    using TopK = internal::TopK<T, Compare>;
+
+    if (k == 0) {
+        return {};
+    }
+    if (k > (static_cast<std::size_t>(std::numeric_limits<int>::max()) - sizeof(std::uint64_t)) /
+                sizeof(T)) {
+        throw std::out_of_range("k is too large");
+    }
+
+    std::vector<T> best(std::min(k, data.size()));
+    std::partial_sort_copy(data.begin(),
+                           data.end(),
+                           best.begin(),
+                           best.end(),
+                           [&](T const &a, T const &b) { return comp(b, a); });
+
+    std::vector<char> record(TopK::record_size(k));
+    TopK::write(record.data(), best);
+
+    auto const datatype = UniqueDatatype::contiguous(static_cast<int>(record.size()), MPI_BYTE);
+    auto const op = UserOp::create(&TopK::merge, true);
+    comm.deref().all_reduce_in_place(op, DynBuffer(record.data(), 1, datatype.datatype()));
+
+    return TopK::read(record.data());
+}
+
+template <typename From, typename T, typename Compare = std::less<T>>
+std::vector<T> distributed_top_k(trait::Deref<From, Comm> const &comm,
+                                 std::vector<T> const &data,
+                                 std::size_t k,
+                                 Compare comp = Compare{}) {
+    return distributed_top_k(comm, nonstd::span<T const>(data), k, comp);
+}
+} // namespace mpi
+
+#endif // MPI_ALGORITHM_HPP
@@ -72,15 +72,15 @@ Buffer<T> MakeBuffer(nonstd::span<T> data) {
     return Buffer<T>(data);
 }
 
-template <typename T>
-Buffer<T> MakeBuffer(std::vector<T> &data) {
+template <typename T, typename A>
+Buffer<T> MakeBuffer(std::vector<T, A> &data) {
     static_assert(is_datatype_v<std::remove_const_t<T>>,
                   "T does not implement mpi::DatatypeTraits");
     return Buffer<T>(nonstd::span<T>(data));
 }
 
-template <typename T>
-Buffer<T const> MakeBuffer(std::vector<T> const &data) {
+template <typename T, typename A>
+Buffer<T const> MakeBuffer(std::vector<T, A> const &data) {
     static_assert(is_datatype_v<std::remove_const_t<T>>,
                   "T does not implement mpi::DatatypeTraits");
     return Buffer<T const>(nonstd::span<T const>(data));
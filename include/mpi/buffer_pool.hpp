@@ -0,0 +1,233 @@
+/**
+ * @file buffer_pool.hpp
+ *
+ * @brief Defines a pool of reusable communication buffers.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+#ifndef MPI_BUFFER_POOL_HPP
+#define MPI_BUFFER_POOL_HPP
+
+#include "mpi_stub_out.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <nonstd/span.hpp>
+
+#include "memory.hpp"
+
+namespace mpi {
+/**
+ * @brief Caches freed buffers in power-of-two size classes, so communication buffers can be reused
+ *  without going through the allocator.
+ *
+ * @details
+ * Requests are rounded up to the next size class, and served from that class' free list when it is
+ * not empty. Released buffers go back on their free list rather than being freed, until `trim()`
+ * or the pool is destroyed, as long as the free lists hold at most `max_cached_bytes`; beyond that,
+ * released buffers are freed. Optionally, buffers are allocated with MPI_Alloc_mem, so that they
+ * may be pre-registered with the network.
+ *
+ * The pool is safe to use from multiple threads.
+ */
+class BufferPool {
+  public:
+    static constexpr std::size_t default_max_cached_bytes = std::size_t(64) << 20;
+
+    /**
+     * @param use_mpi_alloc Whether to allocate buffers with MPI_Alloc_mem instead of `new`.
+     *  MPI must then stay initialized until the pool is destroyed.
+     * @param max_cached_bytes The most memory the free lists may hold
+     */
+    explicit BufferPool(bool use_mpi_alloc = false,
+                        std::size_t max_cached_bytes = default_max_cached_bytes)
+        : use_mpi_alloc_(use_mpi_alloc), max_cached_bytes_(max_cached_bytes) {}
+
+    BufferPool(BufferPool const &) = delete;
+    BufferPool &operator=(BufferPool const &) = delete;
+
+    ~BufferPool() { trim(); }
+
+    /**
+     * @brief Gets a buffer of at least `bytes` bytes, aligned for any fundamental type.
+     *
+     * @param bytes The minimum size of the buffer
+     * @param capacity Receives the actual size of the buffer, which must be passed to `release`
+     */
+    void *acquire(std::size_t bytes, std::size_t &capacity) {
+        auto const size_class = class_of(bytes);
+        capacity = capacity_of(size_class);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (size_class < free_.size() && !free_[size_class].empty()) {
+                auto *const buffer = free_[size_class].back();
+                free_[size_class].pop_back();
+                cached_bytes_ -= capacity;
+                return buffer;
+            }
+        }
+
+        return use_mpi_alloc_ ? alloc_mem(capacity) : ::operator new(capacity);
+    }
+
+    /**
+     * @brief Returns a buffer from `acquire` to the pool.
+     */
+    void release(void *buffer, std::size_t capacity) {
+        if (!buffer) {
+            return;
+        }
+
+        auto const size_class = class_of(capacity);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (capacity <= max_cached_bytes_ - std::min(cached_bytes_, max_cached_bytes_)) {
+                if (size_class >= free_.size()) {
+                    free_.resize(size_class + 1);
+                }
+                free_[size_class].push_back(buffer);
+                cached_bytes_ += capacity;
+                return;
+            }
+        }
+
+        deallocate(buffer);
+    }
+
+    /**
+     * @brief Frees every cached buffer.
+     */
+    void trim() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto &buffers : free_) {
+            for (auto *buffer : buffers) {
+                deallocate(buffer);
+            }
+            buffers.clear();
+        }
+        cached_bytes_ = 0;
+    }
+
+    /**
+     * @brief Gets the total size of the buffers on the free lists.
+     */
+    std::size_t cached_bytes() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return cached_bytes_;
+    }
+
+    bool uses_mpi_alloc() const { return use_mpi_alloc_; }
+
+  private:
+    static constexpr std::size_t min_capacity = 64;
+
+    static std::size_t class_of(std::size_t bytes) {
+        std::size_t size_class = 0;
+        while (capacity_of(size_class) < bytes) {
+            if (capacity_of(size_class) > (std::size_t(-1) >> 1)) {
+                throw std::bad_alloc();
+            }
+            size_class++;
+        }
+        return size_class;
+    }
+
+    static std::size_t capacity_of(std::size_t size_class) { return min_capacity << size_class; }
+
+    void deallocate(void *buffer) const {
+        if (use_mpi_alloc_) {
+            free_mem(buffer);
+        } else {
+            ::operator delete(buffer);
+        }
+    }
+
+    bool use_mpi_alloc_;
+    std::size_t max_cached_bytes_;
+
+    mutable std::mutex mutex_;
+    std::vector<std::vector<void *>> free_;
+    std::size_t cached_bytes_ = 0;
+};
+
+/**
+ * @brief An array of `T`s drawn from a BufferPool, and returned to it on destruction.
+ *
+ * @details
+ * The elements are not initialized, so `T` must be trivial. The buffer keeps its pool alive, so it
+ * may outlive the communicator it came from.
+ */
+template <typename T>
+class PooledBuffer {
+    static_assert(std::is_trivial<T>::value, "PooledBuffer elements are left uninitialized");
+
+  public:
+    using value_type = T;
+
+    PooledBuffer() = default;
+
+    PooledBuffer(std::shared_ptr<BufferPool> pool, std::size_t size)
+        : pool_(std::move(pool)), size_(size) {
+        if (size_ > std::size_t(-1) / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        data_ = static_cast<T *>(pool_->acquire(size_ * sizeof(T), capacity_));
+    }
+
+    PooledBuffer(PooledBuffer &&other) noexcept { swap(other); }
+    PooledBuffer &operator=(PooledBuffer &&other) noexcept {
+        PooledBuffer(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    ~PooledBuffer() {
+        if (pool_) {
+            pool_->release(data_, capacity_);
+        }
+    }
+
+    T *data() { return data_; }
+    T const *data() const { return data_; }
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    T &operator[](std::size_t i) { return data_[i]; }
+    T const &operator[](std::size_t i) const { return data_[i]; }
+
+    T *begin() { return data_; }
+    T *end() { return data_ + size_; }
+    T const *begin() const { return data_; }
+    T const *end() const { return data_ + size_; }
+
+    operator nonstd::span<T>() { return nonstd::span<T>(data_, size_); }
+    operator nonstd::span<T const>() const { return nonstd::span<T const>(data_, size_); }
+
+    void swap(PooledBuffer &other) noexcept {
+        std::swap(pool_, other.pool_);
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+    }
+
+  private:
+    std::shared_ptr<BufferPool> pool_;
+    T *data_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t capacity_ = 0;
+};
+} // namespace mpi
+
+#endif // MPI_BUFFER_POOL_HPP
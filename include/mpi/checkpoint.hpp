@@ -0,0 +1,552 @@
+/**
+ * @file checkpoint.hpp
+ *
+ * @brief Defines a parallel checkpoint writer and reader that funnel I/O through a few aggregator
+ *  processes per node.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+#ifndef MPI_CHECKPOINT_HPP
+#define MPI_CHECKPOINT_HPP
+
+#include "mpi_stub_out.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <nonstd/span.hpp>
+
+#include "comm.hpp"
+#include "deref.hpp"
+#include "exception.hpp"
+#include "file.hpp"
+#include "info.hpp"
+#include "op.hpp"
+#include "serialize.hpp"
+
+namespace mpi {
+/**
+ * @brief How a checkpoint is laid out on the file system.
+ */
+struct CheckpointOptions {
+    /// The number of processes on each node that write on behalf of the others
+    int aggregators_per_node = 1;
+
+    /// The number of data files the checkpoint is split across, each written by a contiguous block
+    /// of ranks
+    int files = 1;
+
+    /// The most bytes an aggregator gathers from its group at a time; larger datasets are gathered
+    /// and written in several steps. At most INT_MAX, since gathers count in ints.
+    std::uint64_t gather_bytes = std::numeric_limits<int>::max();
+
+    /// Hints used to open the data files
+    Info info;
+};
+
+namespace internal {
+/**
+ * @brief Where each process' part of a dataset is stored.
+ */
+struct CheckpointDataset {
+    std::string name;
+    std::uint64_t element_size = 0;
+
+    // The number of elements written by each process, in rank order.
+    std::vector<std::uint64_t> counts;
+
+    // The byte offset of each process' elements within its data file.
+    std::vector<std::uint64_t> offsets;
+};
+
+/**
+ * @brief The contents of the index file, which describes every data file of a checkpoint.
+ */
+struct CheckpointIndex {
+    // "MPICKPT1", to reject files that are not a checkpoint index.
+    static constexpr std::uint64_t magic = 0x3154504b4349504dULL;
+
+    std::uint64_t version = magic;
+
+    // The data file written by each process.
+    std::vector<std::uint32_t> files;
+
+    std::vector<CheckpointDataset> datasets;
+};
+
+inline std::string checkpoint_data_path(std::string const &path, std::uint32_t file) {
+    return path + "." + std::to_string(file);
+}
+} // namespace internal
+
+template <>
+struct Serializer<internal::CheckpointDataset> {
+    static void size(SerialSizer &sizer, internal::CheckpointDataset const &value) {
+        Serializer<std::string>::size(sizer, value.name);
+        Serializer<std::uint64_t>::size(sizer, value.element_size);
+        Serializer<std::vector<std::uint64_t>>::size(sizer, value.counts);
+        Serializer<std::vector<std::uint64_t>>::size(sizer, value.offsets);
+    }
+
+    static void serialize(SerialWriter &writer, internal::CheckpointDataset const &value) {
+        Serializer<std::string>::serialize(writer, value.name);
+        Serializer<std::uint64_t>::serialize(writer, value.element_size);
+        Serializer<std::vector<std::uint64_t>>::serialize(writer, value.counts);
+        Serializer<std::vector<std::uint64_t>>::serialize(writer, value.offsets);
+    }
+
+    static void deserialize(SerialReader &reader, internal::CheckpointDataset &value) {
+        Serializer<std::string>::deserialize(reader, value.name);
+        Serializer<std::uint64_t>::deserialize(reader, value.element_size);
+        Serializer<std::vector<std::uint64_t>>::deserialize(reader, value.counts);
+        Serializer<std::vector<std::uint64_t>>::deserialize(reader, value.offsets);
+    }
+};
+
+template <>
+struct Serializer<internal::CheckpointIndex> {
+    using datasets_t = std::vector<internal::CheckpointDataset>;
+
+    static void size(SerialSizer &sizer, internal::CheckpointIndex const &value) {
+        Serializer<std::uint64_t>::size(sizer, value.version);
+        Serializer<std::vector<std::uint32_t>>::size(sizer, value.files);
+        Serializer<datasets_t>::size(sizer, value.datasets);
+    }
+
+    static void serialize(SerialWriter &writer, internal::CheckpointIndex const &value) {
+        Serializer<std::uint64_t>::serialize(writer, value.version);
+        Serializer<std::vector<std::uint32_t>>::serialize(writer, value.files);
+        Serializer<datasets_t>::serialize(writer, value.datasets);
+    }
+
+    static void deserialize(SerialReader &reader, internal::CheckpointIndex &value) {
+        Serializer<std::uint64_t>::deserialize(reader, value.version);
+        if (value.version != internal::CheckpointIndex::magic) {
+            throw std::runtime_error("not a checkpoint index");
+        }
+
+        Serializer<std::vector<std::uint32_t>>::deserialize(reader, value.files);
+        Serializer<datasets_t>::deserialize(reader, value.datasets);
+    }
+};
+
+/**
+ * @brief Writes a checkpoint as a few large shared files, plus an index describing them.
+ *
+ * @details
+ * Each dataset is the concatenation, in rank order, of the elements every process passes to
+ * `write`. Within each data file, a process' offset is computed with an exclusive scan of the
+ * sizes. The processes on a node are split into `aggregators_per_node` groups, and each group
+ * gathers its data onto its first process, which alone opens the data file. The aggregators of a
+ * file then write their groups' data with one collective call per dataset, or per step of at most
+ * `gather_bytes` bytes for a large dataset. The file system therefore only sees a few writers per
+ * node.
+ *
+ * `commit` writes the index, from rank 0, once every data file is complete, so a checkpoint without
+ * an index is an incomplete one. Elements are stored as raw bytes, so a checkpoint can only be read
+ * back on machines with the same data representation.
+ *
+ * The communicators used for aggregation are cached on `comm`, so checkpoints after the first
+ * do not create any.
+ *
+ * Construction, `write` and `commit` are collective over the communicator.
+ */
+class CheckpointWriter {
+  public:
+    /**
+     * @param comm The processes writing the checkpoint
+     * @param path The path of the index file; data files are named `<path>.<i>`
+     * @throws std::runtime_error on every process if the data files cannot be created
+     */
+    template <typename From>
+    CheckpointWriter(trait::Deref<From, Comm> const &comm,
+                     std::string path,
+                     CheckpointOptions const &options = CheckpointOptions{})
+        : comm_(comm.deref()), path_(std::move(path)) {
+        auto const files = std::max(1, std::min(options.files, comm_.size()));
+        file_ = static_cast<std::uint32_t>(std::int64_t(comm_.rank()) * files / comm_.size());
+        file_comm_ = comm_.split_cached(static_cast<int>(file_), comm_.rank());
+
+        auto node = file_comm_.split_type_cached(SplitType::Shared, file_comm_.rank());
+        auto const groups = std::max(1, std::min(options.aggregators_per_node, node.size()));
+        auto const group = std::int64_t(node.rank()) * groups / node.size();
+        group_ = node.split_cached(static_cast<int>(group), node.rank());
+
+        // Each process contributes at most this much to a step, so a step's gather fits in an int.
+        auto const gather_bytes =
+            std::min<std::uint64_t>(options.gather_bytes, std::numeric_limits<int>::max());
+        step_bytes_ = std::max<std::uint64_t>(1, gather_bytes / group_.size());
+
+        int opened = 1;
+        auto writers =
+            file_comm_.split_cached(group_.rank() == 0 ? 0 : MPI_UNDEFINED, file_comm_.rank());
+        if (writers) {
+            try {
+                data_ = UniqueFile::open(writers,
+                                         internal::checkpoint_data_path(path_, file_),
+                                         FileMode::Create | FileMode::WriteOnly,
+                                         options.info);
+                data_.set_size(0);
+            } catch (Exception const &) {
+                opened = 0;
+            }
+        }
+
+        // Every process must learn of a failure on the aggregators, rather than wait for them
+        // forever in the first collective.
+        if (!comm_.all_reduce(logical_and(), opened)) {
+            throw std::runtime_error("could not create checkpoint data files for " + path_);
+        }
+
+        auto const files_by_rank = comm_.gather_v(0, nonstd::span<std::uint32_t const>(&file_, 1));
+        index_.files.assign(files_by_rank.begin(), files_by_rank.end());
+    }
+
+    /**
+     * @brief Appends this process' part of the dataset `name`.
+     *
+     * @throws std::logic_error if `name` has already been written, or after `commit`
+     * @throws std::runtime_error on every process if an aggregator fails to write
+     */
+    template <typename T>
+    void write(std::string const &name, nonstd::span<T const> data) {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "checkpoint elements are written as bytes, so must be trivially copyable");
+
+        if (committed_) {
+            throw std::logic_error("checkpoint has already been committed");
+        }
+        if (!names_.insert(name).second) {
+            throw std::logic_error("checkpoint dataset \"" + name + "\" was already written");
+        }
+
+        std::uint64_t const bytes = data.size() * sizeof(T);
+        std::uint64_t const offset = end_ + file_comm_.exclusive_scan(sum(), bytes);
+        end_ += file_comm_.all_reduce(sum(), bytes);
+
+        // Every aggregator of the file takes part in each step's collective write, so they all
+        // take as many steps as the largest part needs.
+        std::uint64_t const steps =
+            file_comm_.all_reduce(max(), (bytes + step_bytes_ - 1) / step_bytes_);
+        auto const offsets = group_.gather_v(0, nonstd::span<std::uint64_t const>(&offset, 1));
+
+        auto const *const first = reinterpret_cast<char const *>(data.data());
+        int written = 1;
+        for (std::uint64_t step = 0; step < steps; step++) {
+            auto const begin = std::min(bytes, step * step_bytes_);
+            auto const end = std::min(bytes, begin + step_bytes_);
+
+            std::vector<int> counts;
+            auto const gathered = group_.gather_v(
+                0, nonstd::span<char const>(first + begin, end - begin), &counts);
+            if (data_) {
+                std::vector<std::uint64_t> step_offsets(offsets.size());
+                for (std::size_t i = 0; i < offsets.size(); i++) {
+                    step_offsets[i] = offsets[i] + step * step_bytes_;
+                }
+
+                // Keep taking part in the remaining steps, so the other aggregators don't hang.
+                try {
+                    write_runs(gathered, counts, step_offsets);
+                } catch (Exception const &) {
+                    written = 0;
+                }
+            }
+        }
+
+        if (!comm_.all_reduce(logical_and(), written)) {
+            throw std::runtime_error("could not write checkpoint dataset \"" + name + "\"");
+        }
+
+        std::uint64_t const layout[] = {data.size(), offset};
+        auto const layouts = comm_.gather_v(0, nonstd::span<std::uint64_t const>(layout));
+        if (comm_.rank() == 0) {
+            internal::CheckpointDataset dataset;
+            dataset.name = name;
+            dataset.element_size = sizeof(T);
+            for (std::size_t i = 0; i < layouts.size(); i += 2) {
+                dataset.counts.push_back(layouts[i]);
+                dataset.offsets.push_back(layouts[i + 1]);
+            }
+            index_.datasets.push_back(std::move(dataset));
+        }
+    }
+
+    template <typename T>
+    void write(std::string const &name, std::vector<T> const &data) {
+        write(name, nonstd::span<T const>(data));
+    }
+
+    /**
+     * @brief Closes the data files, then writes the index. The checkpoint is complete on return.
+     */
+    void commit() {
+        if (committed_) {
+            return;
+        }
+        committed_ = true;
+
+        // Closing is collective over the aggregators of the file, and flushes their writes.
+        data_ = UniqueFile();
+        comm_.barrier();
+
+        if (comm_.rank() == 0) {
+            auto const bytes = serialize(index_);
+            auto index =
+                UniqueFile::open(Comm::self(), path_, FileMode::Create | FileMode::WriteOnly);
+            index.set_size(0);
+            index.write_at(0, nonstd::span<char const>(bytes));
+        }
+        comm_.barrier();
+    }
+
+  private:
+    /**
+     * @brief Writes the gathered blocks of a group, merging those that are adjacent in the file.
+     *
+     * @details
+     * The blocks become the file view of this aggregator, so every aggregator of the file writes
+     * its data with one collective call, which lets MPI-IO apply collective buffering (and the
+     * `cb_*` hints) across aggregators.
+     */
+    void write_runs(std::vector<char> const &bytes,
+                    std::vector<int> const &counts,
+                    std::vector<std::uint64_t> const &offsets) {
+        std::vector<int> lengths;
+        std::vector<aint_t> displacements;
+
+        std::size_t i = 0;
+        while (i < counts.size()) {
+            auto const run_offset = offsets[i];
+            std::size_t run_bytes = counts[i];
+            for (i++; i < counts.size() && offsets[i] == run_offset + run_bytes &&
+                      run_bytes + counts[i] <= std::size_t(std::numeric_limits<int>::max());
+                 i++) {
+                run_bytes += counts[i];
+            }
+
+            if (run_bytes > 0) {
+                lengths.push_back(static_cast<int>(run_bytes));
+                displacements.push_back(static_cast<aint_t>(run_offset));
+            }
+        }
+
+        if (lengths.empty()) {
+            data_.set_view(0, MPI_BYTE, MPI_BYTE);
+        } else {
+            auto const filetype = UniqueDatatype::hindexed(lengths, displacements, MPI_BYTE);
+            data_.set_view(0, MPI_BYTE, filetype.datatype());
+        }
+        data_.write_at_all(0, nonstd::span<char const>(bytes));
+    }
+
+    Comm comm_;
+    std::string path_;
+
+    std::uint32_t file_;
+    Comm file_comm_;
+    Comm group_;
+
+    // Only open on the aggregators.
+    UniqueFile data_;
+
+    // The end of the data written to this process' file so far.
+    std::uint64_t end_ = 0;
+
+    // The most bytes this process contributes to one step of a gather.
+    std::uint64_t step_bytes_;
+
+    std::set<std::string> names_;
+    bool committed_ = false;
+
+    // Only filled in on rank 0.
+    internal::CheckpointIndex index_;
+};
+
+/**
+ * @brief Reads a checkpoint written by CheckpointWriter, on any number of processes.
+ *
+ * @details
+ * Rank 0 reads the index and broadcasts it, so the file system sees a single reader for it. The
+ * data files are then opened by every process, and each process reads only the parts of a dataset
+ * it asks for.
+ *
+ * Construction is collective over the communicator.
+ */
+class CheckpointReader {
+  public:
+    /**
+     * @param comm The processes reading the checkpoint
+     * @param path The path of the index file
+     * @param info Hints used to open the data files
+     * @throws std::runtime_error if the index cannot be read
+     */
+    template <typename From>
+    CheckpointReader(trait::Deref<From, Comm> const &comm,
+                     std::string const &path,
+                     Info const &info = Info{})
+        : comm_(comm.deref()) {
+        auto constexpr failed = std::numeric_limits<std::uint64_t>::max();
+
+        std::vector<char> bytes;
+        std::uint64_t size = 0;
+        if (comm_.rank() == 0) {
+            try {
+                auto index = UniqueFile::open(Comm::self(), path, FileMode::ReadOnly);
+                bytes.resize(static_cast<std::size_t>(index.size()));
+                index.read_at(0, nonstd::span<char>(bytes));
+                size = bytes.size();
+            } catch (Exception const &) {
+                size = failed;
+            }
+        }
+
+        // Every process must learn of a failure on rank 0, rather than wait for the index forever.
+        size = comm_.broadcast(0, size);
+        if (size == failed) {
+            throw std::runtime_error("could not read checkpoint index " + path);
+        }
+
+        bytes.resize(size);
+        comm_.broadcast(0, nonstd::span<char>(bytes));
+        index_ = deserialize<internal::CheckpointIndex>(bytes);
+
+        std::uint32_t files = 0;
+        for (auto const file : index_.files) {
+            files = std::max(files, file + 1);
+        }
+        for (std::uint32_t file = 0; file < files; file++) {
+            data_.push_back(UniqueFile::open(
+                comm_, internal::checkpoint_data_path(path, file), FileMode::ReadOnly, info));
+        }
+    }
+
+    /**
+     * @brief The number of processes that wrote the checkpoint.
+     */
+    rank_t saved_ranks() const { return static_cast<rank_t>(index_.files.size()); }
+
+    std::vector<std::string> datasets() const {
+        std::vector<std::string> names;
+        for (auto const &dataset : index_.datasets) {
+            names.push_back(dataset.name);
+        }
+        return names;
+    }
+
+    bool contains(std::string const &name) const { return find(name) != nullptr; }
+
+    /**
+     * @brief The total number of elements of the dataset `name`, over all processes.
+     */
+    std::uint64_t global_size(std::string const &name) const {
+        std::uint64_t total = 0;
+        for (auto const count : at(name).counts) {
+            total += count;
+        }
+        return total;
+    }
+
+    /**
+     * @brief Reads this process' part of the dataset `name`.
+     *
+     * @details
+     * When the checkpoint was written by as many processes as are reading it, each process gets
+     * back exactly what it wrote. Otherwise, the dataset is divided into contiguous blocks of
+     * (nearly) equal size, in rank order.
+     */
+    template <typename T>
+    std::vector<T> read(std::string const &name) {
+        auto const &dataset = at(name);
+
+        if (saved_ranks() == comm_.size()) {
+            std::uint64_t first = 0;
+            for (rank_t r = 0; r < comm_.rank(); r++) {
+                first += dataset.counts[r];
+            }
+            return read<T>(name, first, dataset.counts[comm_.rank()]);
+        }
+
+        auto const total = global_size(name);
+        auto const ranks = static_cast<std::uint64_t>(comm_.size());
+        auto const rank = static_cast<std::uint64_t>(comm_.rank());
+        auto const base = total / ranks;
+        auto const extra = total % ranks;
+        return read<T>(name, base * rank + std::min(rank, extra), base + (rank < extra ? 1 : 0));
+    }
+
+    /**
+     * @brief Reads `count` elements of the dataset `name`, starting from the `first` element over
+     *  all processes.
+     *
+     * @throws std::logic_error if `T` is not the size of the elements that were written
+     * @throws std::out_of_range if the range is not within the dataset
+     */
+    template <typename T>
+    std::vector<T> read(std::string const &name, std::uint64_t first, std::uint64_t count) {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "checkpoint elements are read as bytes, so must be trivially copyable");
+
+        auto const &dataset = at(name);
+        if (dataset.element_size != sizeof(T)) {
+            throw std::logic_error("checkpoint dataset \"" + name + "\" has a different type");
+        }
+        if (first > global_size(name) || count > global_size(name) - first) {
+            throw std::out_of_range("range is outside of checkpoint dataset \"" + name + "\"");
+        }
+
+        std::vector<T> result(count);
+        auto *const bytes = reinterpret_cast<char *>(result.data());
+        auto const last = first + count;
+
+        std::uint64_t start = 0;
+        for (std::size_t r = 0; r < dataset.counts.size() && start < last; r++) {
+            auto const end = start + dataset.counts[r];
+            auto const lo = std::max(first, start);
+            auto const hi = std::min(last, end);
+            if (lo < hi) {
+                auto const offset = dataset.offsets[r] + (lo - start) * sizeof(T);
+                data_[index_.files[r]].read_at(
+                    static_cast<offset_t>(offset),
+                    nonstd::span<char>(bytes + (lo - first) * sizeof(T), (hi - lo) * sizeof(T)));
+            }
+            start = end;
+        }
+        return result;
+    }
+
+  private:
+    internal::CheckpointDataset const *find(std::string const &name) const {
+        for (auto const &dataset : index_.datasets) {
+            if (dataset.name == name) {
+                return &dataset;
+            }
+        }
+        return nullptr;
+    }
+
+    internal::CheckpointDataset const &at(std::string const &name) const {
+        auto const *dataset = find(name);
+        if (!dataset) {
+            throw std::out_of_range("checkpoint has no dataset \"" + name + "\"");
+        }
+        return *dataset;
+    }
+
+    Comm comm_;
+    internal::CheckpointIndex index_;
+    std::vector<UniqueFile> data_;
+};
+} // namespace mpi
+
+#endif // MPI_CHECKPOINT_HPP
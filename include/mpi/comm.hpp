@@ -12,10 +12,18 @@
 
 #include "mpi_stub_out.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <iostream>
 #include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <nonstd/optional.hpp>
@@ -23,15 +31,21 @@
 
 #include "attrs.hpp"
 #include "buffer.hpp"
+#include "buffer_pool.hpp"
 #include "datatype.hpp"
 #include "deref.hpp"
 #include "exception.hpp"
+#include "future.hpp"
 #include "group.hpp"
 #include "handle.hpp"
+#include "info.hpp"
 #include "keyval.hpp"
 #include "op.hpp"
+#include "partitioned.hpp"
 #include "request.hpp"
+#include "serialize.hpp"
 #include "status.hpp"
+#include "tag_allocator.hpp"
 
 namespace mpi {
 struct CommHandleTraits {
@@ -76,10 +90,89 @@ struct CommAttrTraits {
     }
 };
 
+/**
+ * @brief The ways a communicator can be split by `Comm::split_type`.
+ */
+enum class SplitType {
+    /// Processes that can create shared memory with each other, typically those on the same node
+    Shared = MPI_COMM_TYPE_SHARED,
+};
+
+/**
+ * @brief The neighbors of a process along one dimension of a Cartesian communicator.
+ *
+ * @details
+ * Either rank may be MPI_PROC_NULL at the boundary of a non-periodic dimension, in which case
+ * point-to-point operations with it complete immediately without transferring data.
+ */
+struct CartShift {
+    rank_t source;
+    rank_t dest;
+};
+
+/**
+ * @brief The number of neighbors a process receives from and sends to in a neighbor collective.
+ */
+struct NeighborCounts {
+    int sources;
+    int destinations;
+};
+
+/**
+ * @brief Chooses a balanced Cartesian grid of `nodes` processes using MPI_Dims_create.
+ *
+ * @param nodes The number of processes in the grid
+ * @param dims The size of each dimension. Entries of zero are filled in, while non-zero entries
+ *  are kept as given.
+ * @return The size of each dimension, whose product is `nodes`.
+ */
+inline std::vector<int> dims_create(int nodes, std::vector<int> dims) {
+    check_result(MPI_Dims_create(nodes, static_cast<int>(dims.size()), dims.data()));
+    return dims;
+}
+
+/**
+ * @brief The neighbors of a process in a distributed graph communicator, as ranks in that
+ *  communicator.
+ *
+ * @details
+ * The weight vectors are empty if the graph was created without weights.
+ */
+struct DistGraphNeighbors {
+    std::vector<rank_t> sources;
+    std::vector<int> source_weights;
+    std::vector<rank_t> destinations;
+    std::vector<int> destination_weights;
+};
+
 class Comm;
 class UniqueComm;
 
 namespace internal {
+/**
+ * @brief Gets the keyval the library uses to cache a `T` on communicators.
+ *
+ * @details
+ * Each keyval is created on first use and deliberately never freed, since communicators holding
+ * the attribute may outlive any caller. Cached values are copied along with the communicator by
+ * MPI_Comm_dup.
+ */
+template <typename T>
+KeyVal<T> comm_keyval();
+
+/**
+ * @brief Guards the attributes the library caches on communicators, so that concurrent callers
+ *  can neither each attach their own value, nor race with a replacement.
+ *
+ * @details
+ * One mutex serves every attribute and communicator type, since a `Comm` and a `UniqueComm` may
+ * refer to the same communicator.
+ */
+inline std::mutex &comm_attr_mutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
 /**
  * @brief Provides C++-style methods to MPI routines.
  *
@@ -140,6 +233,21 @@ class CommImpl : public trait::Deref<ConcreteType, Comm>,
      */
     UniqueComm dup();
 
+    /**
+     * @brief Duplicates the communicator using MPI_Comm_dup_with_info, replacing its hints with
+     *  `info`, e.g. from `InfoBuilder().no_any_source()`.
+     */
+    UniqueComm dup(Info const &info);
+
+    /**
+     * @brief Gets the hints in use on the communicator.
+     */
+    UniqueInfo get_info() const {
+        UniqueInfo info;
+        check_result(MPI_Comm_get_info(comm(), info.addressof()));
+        return info;
+    }
+
     /**
      * @brief Creates a new MPI Communicator that is a subset of the current communicator using the
      * group.
@@ -151,6 +259,66 @@ class CommImpl : public trait::Deref<ConcreteType, Comm>,
     template <typename From>
     UniqueComm create(trait::Deref<From, Group> const &group);
 
+    /**
+     * @brief Creates a communicator from a group, using MPI_Comm_create_group.
+     *
+     * @details
+     * Unlike `create`, this is only collective over the processes in `group`, so other processes
+     * do not need to take part.
+     *
+     * @param group The processes to include, which must be a subset of this communicator
+     * @param tag Distinguishes concurrent calls with overlapping groups
+     * @return A new, separate mpi::UniqueComm
+     */
+    template <typename From>
+    UniqueComm create_group(trait::Deref<From, Group> const &group, tag_t tag = 0);
+
+    /**
+     * @brief Partitions the communicator into disjoint communicators, one per `color`, using
+     *  MPI_Comm_split.
+     *
+     * @param color The communicator to join. Processes passing MPI_UNDEFINED get a null
+     *  communicator.
+     * @param key Orders the processes within each new communicator, with ties broken by their
+     *  rank in this communicator
+     * @return A new, separate mpi::UniqueComm
+     */
+    UniqueComm split(int color, int key = 0);
+
+    /**
+     * @brief Partitions the communicator by the given type, using MPI_Comm_split_type.
+     *
+     * @param type How to partition the processes
+     * @param key Orders the processes within each new communicator
+     * @return A new, separate mpi::UniqueComm
+     */
+    UniqueComm split_type(SplitType type = SplitType::Shared, int key = 0);
+
+    /**
+     * @brief Like `split`, but reuses the communicator from an earlier call with the same
+     *  arguments.
+     *
+     * @details
+     * Communicators are cached on this communicator as an attribute, and are freed along with it.
+     * A cached communicator is only reused if every process finds its own arguments in the cache,
+     * and all of the cached communicators came from the same earlier call, which costs one
+     * all_reduce instead of the collective setup of a new communicator. Otherwise, every process
+     * creates a new communicator, replacing its cached one.
+     *
+     * Replaced communicators are not freed until this communicator is, since references to them
+     * may still be in use; alternating between many different arguments keeps creating new ones.
+     *
+     * @return A reference to the cached communicator, which remains valid for the lifetime of
+     *  this communicator.
+     */
+    Comm split_cached(int color, int key = 0);
+
+    /**
+     * @brief Like `split_type`, but reuses the communicator from an earlier call with the same
+     *  arguments. See `split_cached`.
+     */
+    Comm split_type_cached(SplitType type = SplitType::Shared, int key = 0);
+
     /**
      * @brief Aborts execution of all processes in the MPI communicator.
      *
@@ -181,17 +349,79 @@ class CommImpl : public trait::Deref<ConcreteType, Comm>,
     /**
      * @brief Retuns the upper-bound for tags that this communicator supports
      *
+     * @details
+     * MPI_TAG_UB is the same on every communicator and never changes, so it is only looked up
+     * once.
+     *
      * @return The maximum tag value, inclusive
      */
     tag_t tag_ub() {
-        tag_t *ub;
-        if (!this->get_attr(MPI_TAG_UB, ub)) {
-            std::cerr << rank()
-                      << ": Internal error: MPI did not provide an MPI_TAG_UB value as required"
-                      << std::endl;
-            abort(EXIT_FAILURE);
+        static tag_t const cached = [this] {
+            tag_t *ub;
+            if (!this->get_attr(MPI_TAG_UB, ub)) {
+                std::cerr << rank()
+                          << ": Internal error: MPI did not provide an MPI_TAG_UB value as required"
+                          << std::endl;
+                abort(EXIT_FAILURE);
+            }
+            return *ub;
+        }();
+        return cached;
+    }
+
+    /**
+     * @brief Gets the allocator of tag ranges for this communicator.
+     *
+     * @details
+     * The allocator is created on first use and cached as an attribute, which is freed along with
+     * the communicator. Duplicates of the communicator get their own allocator.
+     */
+    TagAllocator &tag_allocator() {
+        auto const keyval = comm_keyval<TagAllocator>();
+
+        std::lock_guard<std::mutex> lock(comm_attr_mutex());
+
+        if (auto *allocator = this->get_attr(keyval)) {
+            return *allocator;
+        }
+        return *this->create_attr(keyval, tag_ub());
+    }
+
+    /**
+     * @brief Gets the pool that the `_pooled` collectives and serialized sends draw their buffers
+     *  from.
+     *
+     * @details
+     * The pool is created on first use and cached as an attribute. Duplicates of the communicator
+     * share the pool of the original.
+     */
+    std::shared_ptr<BufferPool> buffer_pool() {
+        auto const keyval = comm_keyval<std::shared_ptr<BufferPool>>();
+
+        std::lock_guard<std::mutex> lock(comm_attr_mutex());
+
+        if (auto *pool = this->get_attr(keyval)) {
+            return *pool;
+        }
+        return *this->create_attr(keyval, std::make_shared<BufferPool>());
+    }
+
+    /**
+     * @brief Replaces the buffer pool of this communicator, e.g. with one that uses MPI_Alloc_mem.
+     *
+     * @details
+     * Buffers drawn from the previous pool stay valid, and are returned to it.
+     */
+    void set_buffer_pool(std::shared_ptr<BufferPool> pool) {
+        auto const keyval = comm_keyval<std::shared_ptr<BufferPool>>();
+
+        std::lock_guard<std::mutex> lock(comm_attr_mutex());
+
+        if (auto *current = this->get_attr(keyval)) {
+            *current = std::move(pool);
+        } else {
+            this->create_attr(keyval, std::move(pool));
         }
-        return *ub;
     }
 
     void gather(rank_t root, DynBuffer send, nonstd::optional<DynBuffer> recv = nonstd::nullopt) {
@@ -212,13 +442,13 @@ class CommImpl : public trait::Deref<ConcreteType, Comm>,
         }
 
         check_result(
-            MPI_Gather(send,
+            MPI_Gather(send.data(),
                        static_cast<int>(send.size_int()),
                        send.datatype(),
-                       recv,
+                       recv ? recv->data() : nullptr,
                        static_cast<int>(send.size_int()), // This is the size of any single buffer,
                                                           // not the size of the receive buffer
-                       recv->datatype(),
+                       recv ? recv->datatype() : send.datatype(),
                        root,
                        comm()));
     }
@@ -227,8 +457,10 @@ class CommImpl : public trait::Deref<ConcreteType, Comm>,
     void gather(rank_t root,
                 nonstd::span<T const> send,
                 nonstd::optional<nonstd::span<T>> recv = nonstd::nullopt) {
-        nonstd::optional<DynBuffer> recv_buf =
-            recv ? DynBuffer(MakeBuffer(*recv)) : nonstd::nullopt;
+        nonstd::optional<DynBuffer> recv_buf;
+        if (recv) {
+            recv_buf = DynBuffer(MakeBuffer(*recv));
+        }
         gather(root, DynBuffer(MakeBuffer(send)), recv_buf);
     }
 
@@ -249,7 +481,7 @@ class CommImpl : public trait::Deref<ConcreteType, Comm>,
             abort(EXIT_FAILURE);
         }
 
-        gather(root, send, recv);
+        gather(root, send, nonstd::optional<nonstd::span<T>>(recv));
     }
 
     template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
@@ -271,6 +503,16 @@ class CommImpl : public trait::Deref<ConcreteType, Comm>,
         return recv;
     }
 
+    /**
+     * @brief Like `gather_into_root(root, send)`, but receives into a buffer from `buffer_pool()`.
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    PooledBuffer<T> gather_into_root_pooled(rank_t root, T const &send) {
+        PooledBuffer<T> recv(buffer_pool(), size());
+        gather_into_root(root, send, nonstd::span<T>(recv));
+        return recv;
+    }
+
     template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
     std::vector<T> all_gather(T const &send) {
         std::vector<T> results(size());
@@ -278,6 +520,16 @@ class CommImpl : public trait::Deref<ConcreteType, Comm>,
         return results;
     }
 
+    /**
+     * @brief Like `all_gather(send)`, but receives into a buffer from `buffer_pool()`.
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    PooledBuffer<T> all_gather_pooled(T const &send) {
+        PooledBuffer<T> results(buffer_pool(), size());
+        all_gather(send, nonstd::span<T>(results));
+        return results;
+    }
+
     template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
     void all_gather(T const &send, nonstd::span<T> recv) {
         if (recv.size() < size()) {
@@ -295,6 +547,36 @@ class CommImpl : public trait::Deref<ConcreteType, Comm>,
                                    comm()));
     }
 
+    /**
+     * @brief Gathers a block of `send.size()` elements from every process onto every process, in
+     *  rank order. Every process must send the same number of elements.
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    void all_gather(nonstd::span<T const> send, nonstd::span<T> recv) {
+        if (send.size() > std::numeric_limits<int>::max()) {
+            throw std::out_of_range("send array is too large");
+        }
+
+        if (recv.size() < send.size() * size()) {
+            throw std::out_of_range("recv buffer is too small for a block from every process");
+        }
+
+        check_result(MPI_Allgather(send.data(),
+                                   static_cast<int>(send.size()),
+                                   DatatypeTraits<T>::mpi_datatype(),
+                                   recv.data(),
+                                   static_cast<int>(send.size()),
+                                   DatatypeTraits<T>::mpi_datatype(),
+                                   comm()));
+    }
+
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    std::vector<T> all_gather(nonstd::span<T const> send) {
+        std::vector<T> recv(send.size() * size());
+        all_gather(send, nonstd::span<T>(recv));
+        return recv;
+    }
+
     void all_to_all(DynBuffer send, DynBuffer recv) {
         if (send.size() < size()) {
             std::cerr << rank() << ": The send buffer, of size " << send.size()
@@ -328,6 +610,153 @@ class CommImpl : public trait::Deref<ConcreteType, Comm>,
         return results;
     }
 
+    /**
+     * @brief Like `all_to_all(send)`, but receives into a buffer from `buffer_pool()`.
+     */
+    template <typename Send>
+    auto all_to_all_pooled(Send const &send)
+        -> PooledBuffer<std::remove_cv_t<typename decltype(MakeBuffer(send))::value_type>> {
+        using T = std::remove_cv_t<typename decltype(MakeBuffer(send))::value_type>;
+        PooledBuffer<T> results(buffer_pool(), size());
+        nonstd::span<T> recv(results);
+        all_to_all(send, recv);
+        return results;
+    }
+
+    /**
+     * @brief Sends a block of a different size to every process, using MPI_Alltoallv.
+     *
+     * @param send_counts The number of elements sent to each process
+     * @param send_displs The offset into `send` of the block for each process
+     * @param recv_counts The number of elements received from each process
+     * @param recv_displs The offset into `recv` of the block from each process
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    void all_to_all_v(nonstd::span<T const> send,
+                      nonstd::span<int const> send_counts,
+                      nonstd::span<int const> send_displs,
+                      nonstd::span<T> recv,
+                      nonstd::span<int const> recv_counts,
+                      nonstd::span<int const> recv_displs) {
+        check_block_layout(send.size(), send_counts, send_displs, size());
+        check_block_layout(recv.size(), recv_counts, recv_displs, size());
+
+        check_result(MPI_Alltoallv(send.data(),
+                                   send_counts.data(),
+                                   send_displs.data(),
+                                   DatatypeTraits<T>::mpi_datatype(),
+                                   recv.data(),
+                                   recv_counts.data(),
+                                   recv_displs.data(),
+                                   DatatypeTraits<T>::mpi_datatype(),
+                                   comm()));
+    }
+
+    /**
+     * @brief Sends consecutive blocks of `send` to each process in turn, exchanging the counts
+     *  first so the receive buffer can be sized.
+     *
+     * @param send_counts The number of elements sent to each process
+     * @param recv_counts If not null, receives the number of elements from each process
+     * @return The blocks received from every process, in rank order.
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    std::vector<T> all_to_all_v(nonstd::span<T const> send,
+                                nonstd::span<int const> send_counts,
+                                std::vector<int> *recv_counts = nullptr) {
+        if (send_counts.size() != static_cast<std::size_t>(size())) {
+            throw std::out_of_range("a send count is required for every process");
+        }
+
+        std::vector<int> counts(size());
+        check_result(
+            MPI_Alltoall(send_counts.data(), 1, MPI_INT, counts.data(), 1, MPI_INT, comm()));
+
+        auto const send_displs = displacements(send_counts);
+        auto const recv_displs = displacements(counts);
+
+        std::vector<T> recv(recv_displs.empty() ? 0
+                                                : std::size_t(recv_displs.back()) + counts.back());
+        all_to_all_v(send,
+                     send_counts,
+                     nonstd::span<int const>(send_displs),
+                     nonstd::span<T>(recv),
+                     nonstd::span<int const>(counts),
+                     nonstd::span<int const>(recv_displs));
+
+        if (recv_counts) {
+            *recv_counts = std::move(counts);
+        }
+        return recv;
+    }
+
+    /**
+     * @brief Sends a message to each of a few destinations, and receives the messages sent to
+     *  this process, without any process knowing in advance who will send to it.
+     *
+     * @details
+     * Implements the nonblocking consensus (NBX) algorithm: every message is sent with a
+     * synchronous send, while incoming messages are probed for and received. Once all of its sends
+     * have been matched, a process enters a non-blocking barrier, and the exchange is over once
+     * the barrier completes. The cost is proportional to the number of messages, rather than to
+     * the size of the communicator as with an all_to_all of counts.
+     *
+     * Messages from a later exchange can be mistaken for messages of this one if they use the same
+     * tag, since a process may still be receiving when another has finished and started the next
+     * exchange. Alternate between two tags for back-to-back exchanges, or separate them with a
+     * barrier.
+     *
+     * @param send The message for each destination. Empty messages are still delivered.
+     * @param tag A tag that no other traffic on this communicator uses during the exchange
+     * @return The message from each process that sent to this one
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    std::map<rank_t, std::vector<T>> sparse_all_to_all(std::map<rank_t, std::vector<T>> const &send,
+                                                       tag_t tag = 0) {
+        std::vector<UniqueRequest> sends;
+        sends.reserve(send.size());
+        for (auto const &message : send) {
+            sends.push_back(immediate_ssend(
+                message.second.data(), message.second.size(), message.first, tag));
+        }
+
+        std::map<rank_t, std::vector<T>> received;
+        UniqueRequest barrier;
+        while (true) {
+            int flag;
+            MPI_Message message;
+            MPI_Status status;
+            check_result(MPI_Improbe(MPI_ANY_SOURCE, tag, comm(), &flag, &message, &status));
+            if (flag) {
+                // Matched probes keep a concurrent receive from stealing the message.
+                auto &buffer = received[status.MPI_SOURCE];
+                buffer.resize(Status(status).count<T>());
+                check_result(MPI_Mrecv(buffer.data(),
+                                       static_cast<int>(buffer.size()),
+                                       DatatypeTraits<T>::mpi_datatype(),
+                                       &message,
+                                       MPI_STATUS_IGNORE));
+            }
+
+            if (barrier) {
+                if (barrier.test()) {
+                    break;
+                }
+            } else {
+                int sent;
+                check_result(MPI_Testall(static_cast<int>(sends.size()),
+                                         reinterpret_cast<MPI_Request *>(sends.data()),
+                                         &sent,
+                                         MPI_STATUSES_IGNORE));
+                if (sent) {
+                    barrier = immediate_barrier();
+                }
+            }
+        }
+
+        return received;
+    }
+
     template <typename OpTraits, typename T, typename = std::enable_if_t<is_datatype_v<T>>>
     void reduce(Op<OpTraits> const &op,
                 rank_t root,
@@ -443,6 +872,135 @@ class CommImpl : public trait::Deref<ConcreteType, Comm>,
         return recv;
     }
 
+    /**
+     * @brief Reduces `data` element-wise across all processes, leaving the result in `data`.
+     *
+     * @details
+     * Also accepts a buffer of a derived datatype, e.g. records combined by a UserOp.
+     */
+    template <typename OpTraits>
+    void all_reduce_in_place(Op<OpTraits> const &op, DynBuffer data) {
+        check_result(MPI_Allreduce(
+            MPI_IN_PLACE, data.data(), data.size_int(), data.datatype(), op.op(), comm()));
+    }
+
+    template <typename OpTraits, typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    void all_reduce_in_place(Op<OpTraits> const &op, nonstd::span<T> data) {
+        static_assert(OpTraits::template is_applicable<T>,
+                      "The supplied data type is not valid for this MPI operation.");
+
+        all_reduce_in_place(op, DynBuffer(MakeBuffer(data)));
+    }
+
+    /**
+     * @brief Combines `send` over the processes ranked below this one, using MPI_Exscan.
+     *
+     * @return The combined value, or a value-initialized `T` on rank 0, for which MPI leaves the
+     *  result undefined.
+     */
+    template <typename OpTraits, typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    T exclusive_scan(Op<OpTraits> const &op, T send) {
+        static_assert(OpTraits::template is_applicable<T>,
+                      "The supplied data type is not valid for this MPI operation.");
+
+        T recv{};
+        check_result(
+            MPI_Exscan(&send, &recv, 1, DatatypeTraits<T>::mpi_datatype(), op.op(), comm()));
+        return rank() == 0 ? T{} : recv;
+    }
+
+    /**
+     * @brief Sends `data` from `root` to every process, overwriting `data` on the others.
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    void broadcast(rank_t root, nonstd::span<T> data) {
+        if (data.size() > std::numeric_limits<int>::max()) {
+            throw std::out_of_range("broadcast buffer is too large");
+        }
+
+        check_result(MPI_Bcast(data.data(),
+                               static_cast<int>(data.size()),
+                               DatatypeTraits<T>::mpi_datatype(),
+                               root,
+                               comm()));
+    }
+
+    /**
+     * @brief Returns the `value` of `root` on every process.
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    T broadcast(rank_t root, T value) {
+        broadcast(root, nonstd::span<T>(&value, 1));
+        return value;
+    }
+
+    /**
+     * @brief Gathers blocks of different sizes onto `root`, using MPI_Gatherv.
+     *
+     * @param recv The buffer to receive into; only used on the root
+     * @param recv_counts The number of elements received from each process; only used on the root
+     * @param recv_displs The offset into `recv` of the block from each process; only used on the
+     *  root
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    void gather_v(rank_t root,
+                  nonstd::span<T const> send,
+                  nonstd::span<T> recv,
+                  nonstd::span<int const> recv_counts,
+                  nonstd::span<int const> recv_displs) {
+        if (send.size() > std::numeric_limits<int>::max()) {
+            throw std::out_of_range("send array is too large");
+        }
+
+        if (rank() == root) {
+            check_block_layout(recv.size(), recv_counts, recv_displs, size());
+        }
+
+        check_result(MPI_Gatherv(send.data(),
+                                 static_cast<int>(send.size()),
+                                 DatatypeTraits<T>::mpi_datatype(),
+                                 recv.data(),
+                                 recv_counts.data(),
+                                 recv_displs.data(),
+                                 DatatypeTraits<T>::mpi_datatype(),
+                                 root,
+                                 comm()));
+    }
+
+    /**
+     * @brief Gathers blocks of different sizes onto `root`, in rank order.
+     *
+     * @param recv_counts If not null, receives the number of elements from each process on the
+     *  root
+     * @return The concatenated blocks on the root, and an empty vector elsewhere.
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    std::vector<T> gather_v(rank_t root,
+                            nonstd::span<T const> send,
+                            std::vector<int> *recv_counts = nullptr) {
+        if (send.size() > std::numeric_limits<int>::max()) {
+            throw std::out_of_range("send array is too large");
+        }
+
+        int const count = static_cast<int>(send.size());
+        std::vector<int> counts(rank() == root ? size() : 0);
+        check_result(MPI_Gather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, root, comm()));
+
+        auto const displs = displacements(counts);
+
+        std::vector<T> recv(displs.empty() ? 0 : std::size_t(displs.back()) + counts.back());
+        gather_v(root,
+                 send,
+                 nonstd::span<T>(recv),
+                 nonstd::span<int const>(counts),
+                 nonstd::span<int const>(displs));
+
+        if (recv_counts) {
+            *recv_counts = std::move(counts);
+        }
+        return recv;
+    }
+
     bool immediate_probe(rank_t source, tag_t tag, Status &status) {
         int flag;
         MPI_Status mpi_status;
@@ -488,6 +1046,28 @@ class CommImpl : public trait::Deref<ConcreteType, Comm>,
         return immediate_send(&send, 1, dest, tag);
     }
 
+    /**
+     * @brief Initiates a synchronous send, using MPI_Issend. The request only completes once the
+     *  matching receive has started.
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    UniqueRequest
+    immediate_ssend(T const send[], std::size_t send_count, rank_t dest, tag_t tag = 0) {
+        if (send_count > std::numeric_limits<int>::max()) {
+            throw std::out_of_range("send array is too large");
+        }
+
+        UniqueRequest request;
+        check_result(MPI_Issend(send,
+                                static_cast<int>(send_count),
+                                DatatypeTraits<T>::mpi_datatype(),
+                                dest,
+                                tag,
+                                comm(),
+                                request.addressof()));
+        return request;
+    }
+
     template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
     UniqueRequest immediate_recv(T recv[], std::size_t recv_count, rank_t source, tag_t tag = 0) {
         if (recv_count > std::numeric_limits<int>::max()) {
@@ -510,12 +1090,265 @@ class CommImpl : public trait::Deref<ConcreteType, Comm>,
         return immediate_recv(&recv, 1, source, tag);
     }
 
+    /**
+     * @brief Initiates a receive of a single value.
+     *
+     * @return A future that owns the receive buffer and produces the received value.
+     */
     template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
-    Status recv_with_status(T recv[], std::size_t recv_count, rank_t source, tag_t tag = 0) {
-        if (recv_count > std::numeric_limits<int>::max()) {
-            throw std::out_of_range("receive array is too large");
-        }
-
+    Future<T> async_recv(rank_t source, tag_t tag = 0) {
+        auto state = std::make_unique<internal::RequestState<T>>();
+        check_result(MPI_Irecv(&state->storage(),
+                               1,
+                               DatatypeTraits<T>::mpi_datatype(),
+                               source,
+                               tag,
+                               comm(),
+                               state->request().addressof()));
+        return Future<T>(std::move(state));
+    }
+
+    /**
+     * @brief Initiates a receive of up to `recv_count` values.
+     *
+     * @return A future that owns the receive buffer and produces the received values. The vector
+     *  always has `recv_count` elements.
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    Future<std::vector<T>> async_recv_vector(std::size_t recv_count, rank_t source, tag_t tag = 0) {
+        if (recv_count > std::numeric_limits<int>::max()) {
+            throw std::out_of_range("receive array is too large");
+        }
+
+        auto state = std::make_unique<internal::RequestState<std::vector<T>>>(recv_count);
+        check_result(MPI_Irecv(state->storage().data(),
+                               static_cast<int>(recv_count),
+                               DatatypeTraits<T>::mpi_datatype(),
+                               source,
+                               tag,
+                               comm(),
+                               state->request().addressof()));
+        return Future<std::vector<T>>(std::move(state));
+    }
+
+    /**
+     * @brief Initiates a send of a copy of `send`.
+     *
+     * @return A future that owns the send buffer and completes once the buffer has been sent.
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    Future<void> async_send(T send, rank_t dest, tag_t tag = 0) {
+        auto state = std::make_unique<internal::RequestState<void, T>>(send);
+        check_result(MPI_Isend(&state->storage(),
+                               1,
+                               DatatypeTraits<T>::mpi_datatype(),
+                               dest,
+                               tag,
+                               comm(),
+                               state->request().addressof()));
+        return Future<void>(std::move(state));
+    }
+
+    /**
+     * @brief Initiates a send of `send`, taking ownership of the vector for the duration of the
+     *  send.
+     *
+     * @return A future that owns the send buffer and completes once the buffer has been sent.
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    Future<void> async_send(std::vector<T> send, rank_t dest, tag_t tag = 0) {
+        if (send.size() > std::numeric_limits<int>::max()) {
+            throw std::out_of_range("send array is too large");
+        }
+
+        auto state =
+            std::make_unique<internal::RequestState<void, std::vector<T>>>(std::move(send));
+        check_result(MPI_Isend(state->storage().data(),
+                               static_cast<int>(state->storage().size()),
+                               DatatypeTraits<T>::mpi_datatype(),
+                               dest,
+                               tag,
+                               comm(),
+                               state->request().addressof()));
+        return Future<void>(std::move(state));
+    }
+
+    /**
+     * @brief Initiates a global, asynchronous barrier operation.
+     *
+     * @return A future that completes once every process has entered the barrier.
+     */
+    Future<void> async_barrier() {
+        auto state = std::make_unique<internal::RequestState<void, int>>(0);
+        check_result(MPI_Ibarrier(comm(), state->request().addressof()));
+        return Future<void>(std::move(state));
+    }
+
+    /**
+     * @brief Initiates a reduction of `send` across all processes.
+     *
+     * @return A future that produces the reduced value.
+     */
+    template <typename OpTraits, typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    Future<T> async_all_reduce(Op<OpTraits> const &op, T send) {
+        static_assert(OpTraits::template is_applicable<T>,
+                      "The supplied data type is not valid for this MPI operation.");
+
+        auto state = std::make_unique<internal::RequestState<T>>(send);
+        check_result(MPI_Iallreduce(MPI_IN_PLACE,
+                                    &state->storage(),
+                                    1,
+                                    DatatypeTraits<T>::mpi_datatype(),
+                                    op.op(),
+                                    comm(),
+                                    state->request().addressof()));
+        return Future<T>(std::move(state));
+    }
+
+    /**
+     * @brief Initiates an element-wise reduction of `send` across all processes.
+     *
+     * @return A future that produces the reduced values.
+     */
+    template <typename OpTraits, typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    Future<std::vector<T>> async_all_reduce(Op<OpTraits> const &op, std::vector<T> send) {
+        static_assert(OpTraits::template is_applicable<T>,
+                      "The supplied data type is not valid for this MPI operation.");
+
+        if (send.size() > std::numeric_limits<int>::max()) {
+            throw std::out_of_range("send array is too large");
+        }
+
+        auto state = std::make_unique<internal::RequestState<std::vector<T>>>(std::move(send));
+        check_result(MPI_Iallreduce(MPI_IN_PLACE,
+                                    state->storage().data(),
+                                    static_cast<int>(state->storage().size()),
+                                    DatatypeTraits<T>::mpi_datatype(),
+                                    op.op(),
+                                    comm(),
+                                    state->request().addressof()));
+        return Future<std::vector<T>>(std::move(state));
+    }
+
+    /**
+     * @brief Initiates a gather of `send` from every process to every process.
+     *
+     * @return A future that produces a vector of every process's value, indexed by rank.
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    Future<std::vector<T>> async_all_gather(T const &send) {
+        auto state = std::make_unique<internal::RequestState<std::vector<T>>>(size());
+        state->storage()[rank()] = send;
+        check_result(MPI_Iallgather(MPI_IN_PLACE,
+                                    0,
+                                    MPI_DATATYPE_NULL,
+                                    state->storage().data(),
+                                    1,
+                                    DatatypeTraits<T>::mpi_datatype(),
+                                    comm(),
+                                    state->request().addressof()));
+        return Future<std::vector<T>>(std::move(state));
+    }
+
+    /**
+     * @brief Initiates a send of any serializable value.
+     *
+     * @details
+     * `value` is serialized into a single buffer from `buffer_pool()`, which the returned future
+     * owns until the send completes. Receive it with `recv_serialized`.
+     *
+     * @return A future that completes once the buffer has been sent.
+     */
+    template <typename T>
+    Future<void> async_send_serialized(T const &value, rank_t dest, tag_t tag = 0) {
+        auto const size = mpi::serialized_size(value);
+        if (size > std::numeric_limits<int>::max()) {
+            throw std::out_of_range("serialized value is too large");
+        }
+
+        auto state = std::make_unique<internal::RequestState<void, PooledBuffer<char>>>(
+            PooledBuffer<char>(buffer_pool(), size));
+        auto &buffer = state->storage();
+        mpi::serialize_into(value, buffer);
+
+        check_result(MPI_Isend(buffer.data(),
+                               static_cast<int>(buffer.size()),
+                               MPI_BYTE,
+                               dest,
+                               tag,
+                               comm(),
+                               state->request().addressof()));
+        return Future<void>(std::move(state));
+    }
+
+    /**
+     * @brief Receives a message of unknown length, sized by probing for it first.
+     *
+     * @param source The source rank, or MPI_ANY_SOURCE
+     * @param tag The message tag, or MPI_ANY_TAG
+     * @param status If not null, receives the status of the message
+     * @throws std::logic_error if the message is not a whole number of `T`s, after receiving it
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    std::vector<T> recv_vector(rank_t source, tag_t tag = 0, Status *status = nullptr) {
+        MPI_Message message;
+        MPI_Status probed;
+        check_result(MPI_Mprobe(source, tag, comm(), &message, &probed));
+
+        // Nothing else can match the probed message, so it is received even when it is not made
+        // of `T`s, rather than lost.
+        int count;
+        check_result(MPI_Get_count(&probed, DatatypeTraits<T>::mpi_datatype(), &count));
+        if (count == MPI_UNDEFINED) {
+            int bytes;
+            check_result(MPI_Get_count(&probed, MPI_BYTE, &bytes));
+            std::vector<char> discarded(bytes);
+            check_result(
+                MPI_Mrecv(discarded.data(), bytes, MPI_BYTE, &message, MPI_STATUS_IGNORE));
+            throw std::logic_error("message size is not a multiple of the datatype size");
+        }
+
+        std::vector<T> recv(count);
+        check_result(MPI_Mrecv(recv.data(),
+                               static_cast<int>(recv.size()),
+                               DatatypeTraits<T>::mpi_datatype(),
+                               &message,
+                               MPI_STATUS_IGNORE));
+
+        if (status) {
+            *status = Status(probed);
+        }
+        return recv;
+    }
+
+    /**
+     * @brief Receives a value sent with `async_send_serialized`.
+     *
+     * @details
+     * `T` must not contain views, since the receive buffer is freed before returning. To
+     * deserialize views, receive the bytes with `recv_vector<char>` and call `deserialize` on them.
+     */
+    template <typename T>
+    T recv_serialized(rank_t source, tag_t tag = 0) {
+        MPI_Message message;
+        MPI_Status probed;
+        check_result(MPI_Mprobe(source, tag, comm(), &message, &probed));
+
+        PooledBuffer<char> buffer(buffer_pool(), Status(probed).count<char>());
+        check_result(MPI_Mrecv(buffer.data(),
+                               static_cast<int>(buffer.size()),
+                               MPI_BYTE,
+                               &message,
+                               MPI_STATUS_IGNORE));
+        return mpi::deserialize<T>(buffer);
+    }
+
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    Status recv_with_status(T recv[], std::size_t recv_count, rank_t source, tag_t tag = 0) {
+        if (recv_count > std::numeric_limits<int>::max()) {
+            throw std::out_of_range("receive array is too large");
+        }
+
         MPI_Status status;
         check_result(MPI_Recv(
             recv, recv_count, DatatypeTraits<T>::mpi_datatype(), source, tag, comm(), &status));
@@ -544,12 +1377,561 @@ class CommImpl : public trait::Deref<ConcreteType, Comm>,
 
     template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
     void recv(T &recv, rank_t source, tag_t tag = 0) {
-        recv(&recv, 1, source, tag);
+        this->recv(&recv, 1, source, tag);
+    }
+
+    /**
+     * @brief Creates the sending side of a partitioned operation over `buffer`.
+     *
+     * @details
+     * `buffer` is split into `partitions` equally sized partitions that are each marked ready
+     * independently. The matching receive must use the same number of partitions. When MPI-4
+     * partitioned communication is unavailable, the operation uses the tags
+     * `[tag, tag + partitions)`.
+     *
+     * @param buffer The buffer to send. It must outlive the returned object.
+     * @param partitions The number of partitions `buffer` is split into
+     * @param dest The destination rank
+     * @param tag The message tag
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    PartitionedSend<T>
+    partitioned_send(nonstd::span<T const> buffer, int partitions, rank_t dest, tag_t tag = 0) {
+        check_partitioned_tags(partitions, tag);
+        return PartitionedSend<T>(comm(), buffer, partitions, dest, tag);
+    }
+
+    /**
+     * @brief Creates the receiving side of a partitioned operation into `buffer`.
+     *
+     * @param buffer The buffer to receive into. It must outlive the returned object.
+     * @param partitions The number of partitions `buffer` is split into
+     * @param source The source rank
+     * @param tag The message tag
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    PartitionedRecv<T>
+    partitioned_recv(nonstd::span<T> buffer, int partitions, rank_t source, tag_t tag = 0) {
+        check_partitioned_tags(partitions, tag);
+        return PartitionedRecv<T>(comm(), buffer, partitions, source, tag);
+    }
+
+    /**
+     * @brief Creates a communicator with a Cartesian topology using MPI_Cart_create.
+     *
+     * @details
+     * With `reorder`, MPI may assign the processes new ranks that better match the grid to the
+     * hardware, so a process' rank in the returned communicator may differ from its rank in this
+     * one. Processes beyond the product of `dims` receive a null communicator.
+     *
+     * @param dims The number of processes along each dimension
+     * @param periods Whether each dimension wraps around
+     * @param reorder Whether MPI may reorder ranks
+     * @return A new, separate mpi::UniqueComm
+     */
+    UniqueComm cart_create(std::vector<int> const &dims,
+                           std::vector<bool> const &periods,
+                           bool reorder = true);
+
+    /**
+     * @brief Gets the number of dimensions of a Cartesian communicator.
+     */
+    int cart_ndims() const {
+        int ndims;
+        check_result(MPI_Cartdim_get(comm(), &ndims));
+        return ndims;
+    }
+
+    /**
+     * @brief Gets the coordinates of `rank` in a Cartesian communicator.
+     */
+    std::vector<int> cart_coords(rank_t rank) const {
+        std::vector<int> coords(cart_ndims());
+        check_result(MPI_Cart_coords(comm(), rank, static_cast<int>(coords.size()), coords.data()));
+        return coords;
+    }
+
+    /**
+     * @brief Gets the coordinates of the local process in a Cartesian communicator.
+     */
+    std::vector<int> cart_coords() const { return cart_coords(rank()); }
+
+    /**
+     * @brief Gets the rank of the process at `coords` in a Cartesian communicator. Coordinates
+     *  along periodic dimensions are wrapped.
+     */
+    rank_t cart_rank(std::vector<int> const &coords) const {
+        if (coords.size() != static_cast<std::size_t>(cart_ndims())) {
+            throw std::out_of_range("coordinates do not match the dimensions of the communicator");
+        }
+
+        int rank;
+        check_result(MPI_Cart_rank(comm(), coords.data(), &rank));
+        return rank;
+    }
+
+    /**
+     * @brief Finds the neighbors to exchange with when shifting data along a dimension of a
+     *  Cartesian communicator.
+     *
+     * @param direction The dimension to shift along
+     * @param displacement The distance to shift. Positive values shift towards higher coordinates.
+     */
+    CartShift cart_shift(int direction, int displacement = 1) const {
+        CartShift shift;
+        check_result(MPI_Cart_shift(comm(), direction, displacement, &shift.source, &shift.dest));
+        return shift;
+    }
+
+    /**
+     * @brief Gets the number of neighbors in the communicator's topology.
+     *
+     * @details
+     * A Cartesian communicator has two neighbors per dimension, ordered as the source and then
+     * the destination of `cart_shift(d, 1)` for each dimension `d`. Neighbors at the boundary of a
+     * non-periodic dimension are MPI_PROC_NULL, and their blocks in neighbor collectives are left
+     * untouched.
+     *
+     * The counts are queried from MPI once, then cached as an attribute on the communicator, since
+     * every neighbor collective needs them. A distributed graph communicator takes them from its
+     * cached `dist_graph_neighbors()` when those are available.
+     *
+     * @throws std::logic_error if the communicator has no topology
+     */
+    NeighborCounts neighbor_counts() const {
+        auto const keyval = comm_keyval<NeighborCounts>();
+
+        std::lock_guard<std::mutex> lock(comm_attr_mutex());
+
+        if (auto const *cached = this->get_attr(keyval)) {
+            return *cached;
+        }
+
+        int topology;
+        check_result(MPI_Topo_test(comm(), &topology));
+
+        NeighborCounts counts;
+        if (topology == MPI_CART) {
+            counts.sources = counts.destinations = 2 * cart_ndims();
+        } else if (topology == MPI_DIST_GRAPH) {
+            if (auto const *neighbors = this->get_attr(comm_keyval<DistGraphNeighbors>())) {
+                counts.sources = static_cast<int>(neighbors->sources.size());
+                counts.destinations = static_cast<int>(neighbors->destinations.size());
+            } else {
+                int weighted;
+                check_result(MPI_Dist_graph_neighbors_count(
+                    comm(), &counts.sources, &counts.destinations, &weighted));
+            }
+        } else if (topology == MPI_GRAPH) {
+            check_result(MPI_Graph_neighbors_count(comm(), rank(), &counts.sources));
+            counts.destinations = counts.sources;
+        } else {
+            throw std::logic_error("communicator has no topology");
+        }
+
+        // Attributes are logically const - they cache state without changing the communicator.
+        auto *self = const_cast<CommImpl *>(this);
+        return *self->create_attr(keyval, counts);
+    }
+
+    /**
+     * @brief Creates a communicator with a distributed graph topology, where each process
+     *  specifies only its own neighbors, using MPI_Dist_graph_create_adjacent.
+     *
+     * @details
+     * With `reorder`, MPI may assign the processes new ranks that place heavily weighted
+     * neighbors close together. The neighbor lists of the returned communicator, in its own
+     * ranks, are cached on it and are available from `dist_graph_neighbors()`.
+     *
+     * @param sources The ranks in this communicator that the process receives from
+     * @param source_weights The weight of each edge from `sources`. Empty for an unweighted graph.
+     * @param destinations The ranks in this communicator that the process sends to
+     * @param destination_weights The weight of each edge to `destinations`. Empty for an unweighted
+     *  graph.
+     * @param reorder Whether MPI may reorder ranks
+     * @return A new, separate mpi::UniqueComm
+     */
+    UniqueComm dist_graph_create_adjacent(std::vector<rank_t> const &sources,
+                                          std::vector<int> const &source_weights,
+                                          std::vector<rank_t> const &destinations,
+                                          std::vector<int> const &destination_weights,
+                                          bool reorder = true);
+
+    /**
+     * @brief Creates an unweighted distributed graph communicator.
+     */
+    UniqueComm dist_graph_create_adjacent(std::vector<rank_t> const &sources,
+                                          std::vector<rank_t> const &destinations,
+                                          bool reorder = true);
+
+    /**
+     * @brief Gets the neighbors of the local process in a distributed graph communicator.
+     *
+     * @details
+     * The neighbors are queried from MPI once, then cached as an attribute on the communicator.
+     * The order of the neighbors is the order used by neighbor collectives.
+     *
+     * @throws std::logic_error if the communicator does not have a distributed graph topology
+     */
+    DistGraphNeighbors const &dist_graph_neighbors() const {
+        auto const keyval = comm_keyval<DistGraphNeighbors>();
+
+        std::lock_guard<std::mutex> lock(comm_attr_mutex());
+
+        if (auto const *cached = this->get_attr(keyval)) {
+            return *cached;
+        }
+
+        int topology;
+        check_result(MPI_Topo_test(comm(), &topology));
+        if (topology != MPI_DIST_GRAPH) {
+            throw std::logic_error("communicator does not have a distributed graph topology");
+        }
+
+        int indegree, outdegree, weighted;
+        check_result(MPI_Dist_graph_neighbors_count(comm(), &indegree, &outdegree, &weighted));
+
+        DistGraphNeighbors neighbors;
+        neighbors.sources.resize(indegree);
+        neighbors.destinations.resize(outdegree);
+        if (weighted) {
+            neighbors.source_weights.resize(indegree);
+            neighbors.destination_weights.resize(outdegree);
+        }
+
+        check_result(
+            MPI_Dist_graph_neighbors(comm(),
+                                     indegree,
+                                     neighbors.sources.data(),
+                                     weighted ? neighbors.source_weights.data() : MPI_UNWEIGHTED,
+                                     outdegree,
+                                     neighbors.destinations.data(),
+                                     weighted ? neighbors.destination_weights.data()
+                                              : MPI_UNWEIGHTED));
+
+        // Attributes are logically const - they cache state without changing the communicator.
+        auto *self = const_cast<CommImpl *>(this);
+        return *self->create_attr(keyval, std::move(neighbors));
+    }
+
+    /**
+     * @brief Gathers `send` from every source neighbor, using MPI_Neighbor_allgather.
+     *
+     * @param send The buffer sent to every destination neighbor
+     * @param recv Receives one block the size of `send` from each source neighbor, in order
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    void neighbor_all_gather(nonstd::span<T const> send, nonstd::span<T> recv) {
+        check_neighbor_blocks(send.size(), recv.size(), neighbor_counts().sources);
+
+        check_result(MPI_Neighbor_allgather(send.data(),
+                                            static_cast<int>(send.size()),
+                                            DatatypeTraits<T>::mpi_datatype(),
+                                            recv.data(),
+                                            static_cast<int>(send.size()),
+                                            DatatypeTraits<T>::mpi_datatype(),
+                                            comm()));
+    }
+
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    std::vector<T> neighbor_all_gather(T const &send) {
+        std::vector<T> recv(neighbor_counts().sources);
+        neighbor_all_gather(nonstd::span<T const>(&send, 1), nonstd::span<T>(recv));
+        return recv;
+    }
+
+    /**
+     * @brief Initiates a neighbor_all_gather. Both buffers must outlive the returned request.
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    UniqueRequest immediate_neighbor_all_gather(nonstd::span<T const> send, nonstd::span<T> recv) {
+        check_neighbor_blocks(send.size(), recv.size(), neighbor_counts().sources);
+
+        UniqueRequest request;
+        check_result(MPI_Ineighbor_allgather(send.data(),
+                                             static_cast<int>(send.size()),
+                                             DatatypeTraits<T>::mpi_datatype(),
+                                             recv.data(),
+                                             static_cast<int>(send.size()),
+                                             DatatypeTraits<T>::mpi_datatype(),
+                                             comm(),
+                                             request.addressof()));
+        return request;
+    }
+
+    /**
+     * @brief Gathers a variable number of elements from every source neighbor, using
+     *  MPI_Neighbor_allgatherv.
+     *
+     * @param send The buffer sent to every destination neighbor
+     * @param recv The buffer to receive into
+     * @param recv_counts The number of elements received from each source neighbor
+     * @param recv_displs The offset into `recv` of the block from each source neighbor
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    void neighbor_all_gather_v(nonstd::span<T const> send,
+                               nonstd::span<T> recv,
+                               nonstd::span<int const> recv_counts,
+                               nonstd::span<int const> recv_displs) {
+        check_block_layout(recv.size(), recv_counts, recv_displs, neighbor_counts().sources);
+
+        check_result(MPI_Neighbor_allgatherv(send.data(),
+                                             static_cast<int>(send.size()),
+                                             DatatypeTraits<T>::mpi_datatype(),
+                                             recv.data(),
+                                             recv_counts.data(),
+                                             recv_displs.data(),
+                                             DatatypeTraits<T>::mpi_datatype(),
+                                             comm()));
+    }
+
+    /**
+     * @brief Initiates a neighbor_all_gather_v. Every buffer must outlive the returned request.
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    UniqueRequest immediate_neighbor_all_gather_v(nonstd::span<T const> send,
+                                                  nonstd::span<T> recv,
+                                                  nonstd::span<int const> recv_counts,
+                                                  nonstd::span<int const> recv_displs) {
+        check_block_layout(recv.size(), recv_counts, recv_displs, neighbor_counts().sources);
+
+        UniqueRequest request;
+        check_result(MPI_Ineighbor_allgatherv(send.data(),
+                                              static_cast<int>(send.size()),
+                                              DatatypeTraits<T>::mpi_datatype(),
+                                              recv.data(),
+                                              recv_counts.data(),
+                                              recv_displs.data(),
+                                              DatatypeTraits<T>::mpi_datatype(),
+                                              comm(),
+                                              request.addressof()));
+        return request;
+    }
+
+    /**
+     * @brief Exchanges an equally sized block with every neighbor, using MPI_Neighbor_alltoall.
+     *
+     * @details
+     * This is the usual halo exchange on a Cartesian communicator: block `i` of `send` goes to
+     * destination neighbor `i`, and block `i` of `recv` comes from source neighbor `i`.
+     *
+     * @param send One block for each destination neighbor
+     * @param recv One block, of the same size, for each source neighbor
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    void neighbor_all_to_all(nonstd::span<T const> send, nonstd::span<T> recv) {
+        auto const block = neighbor_block_size(send.size(), recv.size());
+
+        check_result(MPI_Neighbor_alltoall(send.data(),
+                                           block,
+                                           DatatypeTraits<T>::mpi_datatype(),
+                                           recv.data(),
+                                           block,
+                                           DatatypeTraits<T>::mpi_datatype(),
+                                           comm()));
+    }
+
+    /**
+     * @brief Initiates a neighbor_all_to_all. Both buffers must outlive the returned request.
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    UniqueRequest immediate_neighbor_all_to_all(nonstd::span<T const> send, nonstd::span<T> recv) {
+        auto const block = neighbor_block_size(send.size(), recv.size());
+
+        UniqueRequest request;
+        check_result(MPI_Ineighbor_alltoall(send.data(),
+                                            block,
+                                            DatatypeTraits<T>::mpi_datatype(),
+                                            recv.data(),
+                                            block,
+                                            DatatypeTraits<T>::mpi_datatype(),
+                                            comm(),
+                                            request.addressof()));
+        return request;
+    }
+
+    /**
+     * @brief Exchanges a variable number of elements with every neighbor, using
+     *  MPI_Neighbor_alltoallv.
+     *
+     * @param send The buffer holding the blocks for the destination neighbors
+     * @param send_counts The number of elements sent to each destination neighbor
+     * @param send_displs The offset into `send` of the block for each destination neighbor
+     * @param recv The buffer to receive into
+     * @param recv_counts The number of elements received from each source neighbor
+     * @param recv_displs The offset into `recv` of the block from each source neighbor
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    void neighbor_all_to_all_v(nonstd::span<T const> send,
+                               nonstd::span<int const> send_counts,
+                               nonstd::span<int const> send_displs,
+                               nonstd::span<T> recv,
+                               nonstd::span<int const> recv_counts,
+                               nonstd::span<int const> recv_displs) {
+        auto const counts = neighbor_counts();
+        check_block_layout(send.size(), send_counts, send_displs, counts.destinations);
+        check_block_layout(recv.size(), recv_counts, recv_displs, counts.sources);
+
+        check_result(MPI_Neighbor_alltoallv(send.data(),
+                                            send_counts.data(),
+                                            send_displs.data(),
+                                            DatatypeTraits<T>::mpi_datatype(),
+                                            recv.data(),
+                                            recv_counts.data(),
+                                            recv_displs.data(),
+                                            DatatypeTraits<T>::mpi_datatype(),
+                                            comm()));
+    }
+
+    /**
+     * @brief Exchanges a vector with every neighbor.
+     *
+     * @details
+     * The element counts are exchanged first with a neighbor_all_to_all, so that each process only
+     * needs to know what it sends. Only buffers for actual neighbors are allocated, making this
+     * suitable for sparse, irregular exchanges on graph communicators.
+     *
+     * @param send One vector for each destination neighbor, in neighbor order
+     * @return One vector from each source neighbor, in neighbor order
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    std::vector<std::vector<T>> neighbor_all_to_all_v(std::vector<std::vector<T>> const &send) {
+        auto const counts = neighbor_counts();
+        if (send.size() != static_cast<std::size_t>(counts.destinations)) {
+            throw std::out_of_range("neighbor_all_to_all_v requires a vector for every neighbor");
+        }
+
+        std::vector<int> send_counts(counts.destinations);
+        std::vector<int> send_displs(counts.destinations);
+        std::vector<T> send_buffer;
+        for (std::size_t i = 0; i < send.size(); i++) {
+            send_counts[i] = static_cast<int>(send[i].size());
+            send_displs[i] = static_cast<int>(send_buffer.size());
+            send_buffer.insert(send_buffer.end(), send[i].begin(), send[i].end());
+        }
+
+        std::vector<int> recv_counts(counts.sources);
+        neighbor_all_to_all<int>(send_counts, recv_counts);
+
+        std::vector<int> recv_displs(counts.sources);
+        int total = 0;
+        for (int i = 0; i < counts.sources; i++) {
+            recv_displs[i] = total;
+            total += recv_counts[i];
+        }
+
+        std::vector<T> recv_buffer(total);
+        neighbor_all_to_all_v<T>(
+            send_buffer, send_counts, send_displs, recv_buffer, recv_counts, recv_displs);
+
+        std::vector<std::vector<T>> recv(counts.sources);
+        for (int i = 0; i < counts.sources; i++) {
+            auto const first = recv_buffer.begin() + recv_displs[i];
+            recv[i].assign(first, first + recv_counts[i]);
+        }
+        return recv;
+    }
+
+    /**
+     * @brief Initiates a neighbor_all_to_all_v. Every buffer must outlive the returned request.
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    UniqueRequest immediate_neighbor_all_to_all_v(nonstd::span<T const> send,
+                                                  nonstd::span<int const> send_counts,
+                                                  nonstd::span<int const> send_displs,
+                                                  nonstd::span<T> recv,
+                                                  nonstd::span<int const> recv_counts,
+                                                  nonstd::span<int const> recv_displs) {
+        auto const counts = neighbor_counts();
+        check_block_layout(send.size(), send_counts, send_displs, counts.destinations);
+        check_block_layout(recv.size(), recv_counts, recv_displs, counts.sources);
+
+        UniqueRequest request;
+        check_result(MPI_Ineighbor_alltoallv(send.data(),
+                                             send_counts.data(),
+                                             send_displs.data(),
+                                             DatatypeTraits<T>::mpi_datatype(),
+                                             recv.data(),
+                                             recv_counts.data(),
+                                             recv_displs.data(),
+                                             DatatypeTraits<T>::mpi_datatype(),
+                                             comm(),
+                                             request.addressof()));
+        return request;
     }
 
   protected:
     // Make it impossible to construct a CommImpl directly.
     CommImpl() = default;
+
+  private:
+    template <typename Factory>
+    Comm derived_cached(std::tuple<int, int, int> const &id, Factory &&factory);
+
+    static void check_neighbor_blocks(std::size_t block, std::size_t recv_size, int neighbors) {
+        if (recv_size < block * neighbors) {
+            throw std::out_of_range("recv buffer is too small for a block from every neighbor");
+        }
+    }
+
+    int neighbor_block_size(std::size_t send_size, std::size_t recv_size) const {
+        auto const counts = neighbor_counts();
+        if (counts.destinations == 0) {
+            return 0;
+        }
+
+        if (send_size % counts.destinations != 0) {
+            throw std::logic_error("send buffer must hold an equal block for every neighbor");
+        }
+
+        auto const block = send_size / counts.destinations;
+        check_neighbor_blocks(block, recv_size, counts.sources);
+        return static_cast<int>(block);
+    }
+
+    /**
+     * @brief Computes the offsets of consecutive blocks with the given sizes.
+     */
+    static std::vector<int> displacements(nonstd::span<int const> counts) {
+        std::vector<int> displs(counts.size());
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < counts.size(); i++) {
+            if (total > static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+                throw std::out_of_range("blocks are too large in total");
+            }
+            displs[i] = static_cast<int>(total);
+            total += counts[i];
+        }
+        return displs;
+    }
+
+    static void check_block_layout(std::size_t buffer_size,
+                                   nonstd::span<int const> counts,
+                                   nonstd::span<int const> displs,
+                                   int blocks) {
+        if (counts.size() < static_cast<std::size_t>(blocks) ||
+            displs.size() < static_cast<std::size_t>(blocks)) {
+            throw std::out_of_range("counts and displacements are required for every block");
+        }
+
+        for (int i = 0; i < blocks; i++) {
+            if (counts[i] < 0 || displs[i] < 0 ||
+                static_cast<std::size_t>(displs[i]) + counts[i] > buffer_size) {
+                throw std::out_of_range("block lies outside of the buffer");
+            }
+        }
+    }
+
+    void check_partitioned_tags(int partitions, tag_t tag) {
+#ifndef MPI_CPP_HAS_PARTITIONED
+        if (partitions > 0 && tag > tag_ub() - (partitions - 1)) {
+            throw std::out_of_range("not enough tags above `tag` for partitioned operations");
+        }
+#else
+        (void)partitions;
+        (void)tag;
+#endif
+    }
 };
 } // namespace internal
 
@@ -563,6 +1945,7 @@ class Comm : public internal::Handle<CommHandleTraits>, public internal::CommImp
     Comm() = default;
 
     static Comm world() { return from_handle(MPI_COMM_WORLD); }
+    static Comm self() { return from_handle(MPI_COMM_SELF); }
     static Comm from_handle(MPI_Comm handle) { return Comm{handle}; }
 };
 
@@ -584,6 +1967,42 @@ class UniqueComm : public internal::UniqueHandle<CommHandleTraits>,
 static_assert(sizeof(UniqueComm) == sizeof(MPI_Comm),
               "UniqueComm is expected to be the same size as MPI_Comm");
 
+namespace internal {
+/**
+ * @brief The communicators cached by `Comm::split_cached` and `Comm::split_type_cached`.
+ *
+ * @details
+ * Each communicator is keyed by (split type, color, key), where the split type is MPI_UNDEFINED
+ * for plain splits, and tagged with the epoch of the call that created it. Epochs count the
+ * creating calls, which are collective, so they agree on every process. Matching arguments alone
+ * do not identify a communicator, since the other processes may have passed different arguments
+ * at the time; matching epochs do. Not copied by MPI_Comm_dup, since the duplicate is a different
+ * parent.
+ */
+struct DerivedComms {
+    struct Entry {
+        UniqueComm comm;
+        std::int64_t epoch;
+    };
+
+    DerivedComms() = default;
+    DerivedComms(DerivedComms const &) = delete;
+
+    std::map<std::tuple<int, int, int>, Entry> comms;
+    std::int64_t epoch = 0;
+
+    // Replaced communicators are kept alive until the parent is freed, since references to them
+    // may still be in use. This grows by one communicator per replacement.
+    std::vector<UniqueComm> retired;
+};
+} // namespace internal
+
+template <typename T>
+KeyVal<T> internal::comm_keyval() {
+    static key_t const keyval = Comm::create_keyval<T>().into_raw();
+    return KeyVal<T>::from_handle(keyval);
+}
+
 template <typename ConcreteType>
 UniqueComm internal::CommImpl<ConcreteType>::dup() {
     UniqueComm c;
@@ -591,6 +2010,77 @@ UniqueComm internal::CommImpl<ConcreteType>::dup() {
     return c;
 }
 
+template <typename ConcreteType>
+UniqueComm internal::CommImpl<ConcreteType>::dup(Info const &info) {
+    UniqueComm c;
+    check_result(MPI_Comm_dup_with_info(comm(), info.info(), c.addressof()));
+    return c;
+}
+
+template <typename ConcreteType>
+UniqueComm internal::CommImpl<ConcreteType>::cart_create(std::vector<int> const &dims,
+                                                         std::vector<bool> const &periods,
+                                                         bool reorder) {
+    if (dims.size() != periods.size()) {
+        throw std::logic_error("cart_create requires a period for every dimension");
+    }
+
+    std::vector<int> const int_periods(periods.begin(), periods.end());
+
+    UniqueComm c;
+    check_result(MPI_Cart_create(comm(),
+                                 static_cast<int>(dims.size()),
+                                 dims.data(),
+                                 int_periods.data(),
+                                 reorder ? 1 : 0,
+                                 c.addressof()));
+    return c;
+}
+
+template <typename ConcreteType>
+UniqueComm internal::CommImpl<ConcreteType>::dist_graph_create_adjacent(
+    std::vector<rank_t> const &sources,
+    std::vector<int> const &source_weights,
+    std::vector<rank_t> const &destinations,
+    std::vector<int> const &destination_weights,
+    bool reorder) {
+    bool const weighted = !source_weights.empty() || !destination_weights.empty();
+    if (weighted && (source_weights.size() != sources.size() ||
+                     destination_weights.size() != destinations.size())) {
+        throw std::logic_error("dist_graph_create_adjacent requires a weight for every edge");
+    }
+
+    // An empty weight array may have a null data() pointer, which MPI would take as unweighted.
+    int const *const sweights = !weighted ? MPI_UNWEIGHTED
+                                : sources.empty() ? MPI_WEIGHTS_EMPTY
+                                                  : source_weights.data();
+    int const *const dweights = !weighted ? MPI_UNWEIGHTED
+                                : destinations.empty() ? MPI_WEIGHTS_EMPTY
+                                                       : destination_weights.data();
+
+    UniqueComm c;
+    check_result(MPI_Dist_graph_create_adjacent(comm(),
+                                                static_cast<int>(sources.size()),
+                                                sources.data(),
+                                                sweights,
+                                                static_cast<int>(destinations.size()),
+                                                destinations.data(),
+                                                dweights,
+                                                MPI_INFO_NULL,
+                                                reorder ? 1 : 0,
+                                                c.addressof()));
+
+    // Populate the neighbor cache while the lists are known to be needed.
+    c.dist_graph_neighbors();
+    return c;
+}
+
+template <typename ConcreteType>
+UniqueComm internal::CommImpl<ConcreteType>::dist_graph_create_adjacent(
+    std::vector<rank_t> const &sources, std::vector<rank_t> const &destinations, bool reorder) {
+    return dist_graph_create_adjacent(sources, {}, destinations, {}, reorder);
+}
+
 template <typename ConcreteType>
 template <typename From>
 UniqueComm internal::CommImpl<ConcreteType>::create(trait::Deref<From, Group> const &group) {
@@ -598,6 +2088,93 @@ UniqueComm internal::CommImpl<ConcreteType>::create(trait::Deref<From, Group> co
     check_result(MPI_Comm_create(comm(), group.deref(), c.addressof()));
     return c;
 }
+
+template <typename ConcreteType>
+template <typename From>
+UniqueComm internal::CommImpl<ConcreteType>::create_group(trait::Deref<From, Group> const &group,
+                                                          tag_t tag) {
+    UniqueComm c;
+    check_result(MPI_Comm_create_group(comm(), group.deref(), tag, c.addressof()));
+    return c;
+}
+
+template <typename ConcreteType>
+UniqueComm internal::CommImpl<ConcreteType>::split(int color, int key) {
+    UniqueComm c;
+    check_result(MPI_Comm_split(comm(), color, key, c.addressof()));
+    return c;
+}
+
+template <typename ConcreteType>
+UniqueComm internal::CommImpl<ConcreteType>::split_type(SplitType type, int key) {
+    UniqueComm c;
+    check_result(
+        MPI_Comm_split_type(comm(), static_cast<int>(type), key, MPI_INFO_NULL, c.addressof()));
+    return c;
+}
+
+template <typename ConcreteType>
+Comm internal::CommImpl<ConcreteType>::split_cached(int color, int key) {
+    return derived_cached(std::make_tuple(MPI_UNDEFINED, color, key),
+                          [&] { return split(color, key); });
+}
+
+template <typename ConcreteType>
+Comm internal::CommImpl<ConcreteType>::split_type_cached(SplitType type, int key) {
+    return derived_cached(std::make_tuple(static_cast<int>(type), 0, key),
+                          [&] { return split_type(type, key); });
+}
+
+template <typename ConcreteType>
+template <typename Factory>
+Comm internal::CommImpl<ConcreteType>::derived_cached(std::tuple<int, int, int> const &id,
+                                                      Factory &&factory) {
+    auto const keyval = comm_keyval<DerivedComms>();
+
+    // The mutex guards the cache itself, but is never held across a collective: a process blocked
+    // in one while holding it could keep another thread from reaching a collective its peers wait
+    // on. Collectives on one communicator are never concurrent, so the entry for `id` cannot
+    // change in between.
+    DerivedComms *cache;
+    std::int64_t epoch = -1;
+    {
+        std::lock_guard<std::mutex> lock(comm_attr_mutex());
+
+        cache = this->get_attr(keyval);
+        if (!cache) {
+            cache = this->create_attr(keyval);
+        }
+
+        auto const it = cache->comms.find(id);
+        if (it != cache->comms.end()) {
+            epoch = it->second.epoch;
+        }
+    }
+
+    // Creating a communicator is collective, so if any process missed, all of them must create a
+    // new one - even those with a cached communicator, whose group may now be different. The same
+    // goes when the processes hit entries from different calls. Reducing (epoch, -epoch) with min
+    // finds the smallest and largest epoch at once; a miss counts as epoch -1.
+    std::int64_t range[] = {epoch, -epoch};
+    all_reduce_in_place(min(), nonstd::span<std::int64_t>(range));
+    if (range[0] >= 0 && range[0] == -range[1]) {
+        std::lock_guard<std::mutex> lock(comm_attr_mutex());
+        return cache->comms.find(id)->second.comm.deref();
+    }
+
+    auto comm = factory();
+
+    std::lock_guard<std::mutex> lock(comm_attr_mutex());
+    DerivedComms::Entry entry{std::move(comm), cache->epoch++};
+    auto it = cache->comms.find(id);
+    if (it != cache->comms.end()) {
+        cache->retired.push_back(std::move(it->second.comm));
+        it->second = std::move(entry);
+    } else {
+        it = cache->comms.emplace(id, std::move(entry)).first;
+    }
+    return it->second.comm.deref();
+}
 } // namespace mpi
 
 #endif // MPI_COMM_HPP
\ No newline at end of file
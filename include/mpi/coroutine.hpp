@@ -0,0 +1,327 @@
+/**
+ * @file coroutine.hpp
+ *
+ * @brief Defines C++20 coroutine support for awaiting requests, along with a single-threaded
+ *  scheduler for running communication tasks.
+ * @date 2026-10-16
+ *
+ * @details
+ * Only available when the compiler supports C++20 coroutines, in which case
+ * `MPI_CPP_HAS_COROUTINES` is defined. Including this header otherwise defines nothing.
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+#ifndef MPI_COROUTINE_HPP
+#define MPI_COROUTINE_HPP
+
+#if defined(__has_include)
+#if __has_include(<coroutine>) && defined(__cpp_impl_coroutine)
+#define MPI_CPP_HAS_COROUTINES 1
+#endif
+#endif
+
+#ifdef MPI_CPP_HAS_COROUTINES
+
+#include "mpi_stub_out.h"
+
+#include <algorithm>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "exception.hpp"
+#include "request.hpp"
+#include "status.hpp"
+
+namespace mpi {
+class Scheduler;
+
+/**
+ * @brief A communication task run by a Scheduler.
+ *
+ * @details
+ * A Task does not start running until it is handed to `Scheduler::spawn`. Inside a task, requests
+ * returned by the `Comm::immediate_*` routines can be awaited with `co_await`, which suspends the
+ * task until the request completes and produces its Status.
+ */
+class Task {
+  public:
+    struct promise_type {
+        Task get_return_object() {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+
+        void return_void() {}
+        void unhandled_exception() { exception = std::current_exception(); }
+
+        std::exception_ptr exception;
+    };
+
+    using handle_t = std::coroutine_handle<promise_type>;
+
+    Task(Task &&other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    Task &operator=(Task &&other) noexcept {
+        if (this != &other) {
+            reset();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    ~Task() { reset(); }
+
+    /**
+     * @brief Releases ownership of the coroutine, to be adopted by a Scheduler.
+     */
+    handle_t into_handle() { return std::exchange(handle_, nullptr); }
+
+  private:
+    explicit Task(handle_t handle) : handle_(handle) {}
+
+    void reset() {
+        if (handle_) {
+            handle_.destroy();
+            handle_ = nullptr;
+        }
+    }
+
+    handle_t handle_;
+};
+
+/**
+ * @brief Suspends the awaiting task until a request completes.
+ */
+class RequestAwaiter {
+  public:
+    explicit RequestAwaiter(UniqueRequest &&request) : request_(std::move(request)) {}
+
+    bool await_ready() { return request_.test_with_status(status_); }
+    void await_suspend(std::coroutine_handle<> handle);
+    Status await_resume() const { return status_; }
+
+  private:
+    friend class Scheduler;
+
+    UniqueRequest request_;
+    Status status_;
+    std::coroutine_handle<> handle_;
+};
+
+/**
+ * @brief Awaits a request, e.g. `co_await comm.immediate_recv(value, source)`.
+ *
+ * @return The status of the completed request.
+ */
+inline RequestAwaiter operator co_await(UniqueRequest &&request) {
+    return RequestAwaiter(std::move(request));
+}
+
+/**
+ * @brief Runs tasks on the calling thread, resuming each one as the requests it awaits complete.
+ *
+ * @details
+ * The requests of all suspended tasks are kept in one contiguous array, and are driven together
+ * with MPI_Testsome (or MPI_Waitsome when no task is runnable), so thousands of concurrent tasks
+ * cost a single MPI call per progress step.
+ */
+class Scheduler {
+  public:
+    Scheduler() = default;
+
+    Scheduler(Scheduler const &) = delete;
+    Scheduler &operator=(Scheduler const &) = delete;
+
+    ~Scheduler() {
+        // Buffers referenced by pending requests live in the coroutine frames, so the requests
+        // must complete before the frames are destroyed. Requests are only left behind when a
+        // task threw out of `run` or `poll`, and their peers may never match them, so cancel them
+        // first; waiting for a cancelled request is guaranteed to return.
+        if (!requests_.empty()) {
+            for (auto &request : requests_) {
+                MPI_Cancel(&request);
+            }
+            MPI_Waitall(static_cast<int>(requests_.size()), requests_.data(), MPI_STATUSES_IGNORE);
+        }
+
+        for (auto handle : ready_) {
+            destroy(handle);
+        }
+
+        for (auto waiter : waiters_) {
+            destroy(waiter->handle_);
+        }
+    }
+
+    /**
+     * @brief Queues a task to run. It starts running during the next call to `poll` or `run`.
+     */
+    void spawn(Task task) {
+        ready_.push_back(task.into_handle());
+        live_++;
+    }
+
+    /**
+     * @brief The number of tasks that have not yet finished.
+     */
+    std::size_t live() const { return live_; }
+
+    /**
+     * @brief Resumes every runnable task, then completes any finished requests without blocking.
+     *
+     * @return True if there are still unfinished tasks.
+     *
+     * @throws The first exception that escaped a task.
+     */
+    bool poll() {
+        resume_ready();
+        progress(false);
+        return live_ > 0;
+    }
+
+    /**
+     * @brief Runs until every task has finished.
+     *
+     * @throws The first exception that escaped a task.
+     */
+    void run() {
+        while (live_ > 0) {
+            resume_ready();
+            if (ready_.empty()) {
+                progress(true);
+            }
+        }
+    }
+
+    /**
+     * @brief The scheduler running the task on this thread, or nullptr outside of a task.
+     */
+    static Scheduler *current() { return current_slot(); }
+
+  private:
+    friend class RequestAwaiter;
+
+    static Scheduler *&current_slot() {
+        static thread_local Scheduler *current = nullptr;
+        return current;
+    }
+
+    void suspend(RequestAwaiter *waiter) {
+        if (requests_.size() >= static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+            throw std::out_of_range("too many requests in Scheduler");
+        }
+
+        requests_.push_back(waiter->request_.into_raw());
+        waiters_.push_back(waiter);
+    }
+
+    void resume_ready() {
+        auto *const previous = std::exchange(current_slot(), this);
+
+        while (!ready_.empty()) {
+            auto handle = ready_.front();
+            ready_.pop_front();
+
+            handle.resume();
+
+            if (handle.done()) {
+                auto const exception =
+                    Task::handle_t::from_address(handle.address()).promise().exception;
+                destroy(handle);
+
+                if (exception) {
+                    current_slot() = previous;
+                    std::rethrow_exception(exception);
+                }
+            }
+        }
+
+        current_slot() = previous;
+    }
+
+    void progress(bool block) {
+        if (requests_.empty()) {
+            if (block && live_ > 0) {
+                throw std::logic_error("mpi::Scheduler has tasks that are not awaiting requests");
+            }
+            return;
+        }
+
+        indices_.resize(requests_.size());
+        statuses_.resize(requests_.size());
+
+        int num_completed;
+        if (block) {
+            check_result(MPI_Waitsome(static_cast<int>(requests_.size()),
+                                      requests_.data(),
+                                      &num_completed,
+                                      indices_.data(),
+                                      statuses_.data()));
+        } else {
+            check_result(MPI_Testsome(static_cast<int>(requests_.size()),
+                                      requests_.data(),
+                                      &num_completed,
+                                      indices_.data(),
+                                      statuses_.data()));
+        }
+
+        // Compact from the back, so the request moved into each completed slot is still active.
+        completed_.clear();
+        for (int i = 0; i < num_completed; i++) {
+            completed_.push_back(i);
+        }
+        std::sort(completed_.begin(), completed_.end(), [this](int a, int b) {
+            return indices_[a] > indices_[b];
+        });
+
+        for (auto i : completed_) {
+            auto const index = static_cast<std::size_t>(indices_[i]);
+            auto *const waiter = waiters_[index];
+            waiter->status_ = Status(statuses_[i]);
+            ready_.push_back(waiter->handle_);
+
+            requests_[index] = requests_.back();
+            waiters_[index] = waiters_.back();
+            requests_.pop_back();
+            waiters_.pop_back();
+        }
+    }
+
+    void destroy(std::coroutine_handle<> handle) {
+        handle.destroy();
+        live_--;
+    }
+
+    std::deque<std::coroutine_handle<>> ready_;
+    std::size_t live_ = 0;
+
+    std::vector<MPI_Request> requests_;
+    std::vector<RequestAwaiter *> waiters_;
+
+    std::vector<int> indices_;
+    std::vector<MPI_Status> statuses_;
+    std::vector<int> completed_;
+};
+
+inline void RequestAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    auto *const scheduler = Scheduler::current();
+    if (!scheduler) {
+        throw std::logic_error("requests can only be awaited from a task run by mpi::Scheduler");
+    }
+
+    handle_ = handle;
+    scheduler->suspend(this);
+}
+} // namespace mpi
+
+#endif // MPI_CPP_HAS_COROUTINES
+
+#endif // MPI_COROUTINE_HPP
@@ -0,0 +1,163 @@
+/**
+ * @file counter.hpp
+ *
+ * @brief Defines a global atomic counter implemented using one-sided MPI operations.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+#ifndef MPI_COUNTER_HPP
+#define MPI_COUNTER_HPP
+
+#include "mpi_stub_out.h"
+
+#include <cstdint>
+#include <stdexcept>
+
+#include "comm.hpp"
+#include "datatype.hpp"
+#include "deref.hpp"
+#include "op.hpp"
+#include "win.hpp"
+
+namespace mpi {
+/**
+ * @brief A counter that any rank can atomically update without involving the owning rank.
+ *
+ * @details
+ * The counter may be split into several independent shards, each living on a different rank, to
+ * spread contention across the communicator. Every rank has a "home" shard that `fetch_add(value)`
+ * targets; the logical value of the counter is the sum of all shards.
+ *
+ * Construction and destruction are collective over the communicator.
+ *
+ * @tparam T An integer type supported by MPI_Fetch_and_op
+ */
+template <typename T = std::int64_t>
+class GlobalCounter {
+    static_assert(DatatypeTraits<T>::is_c_integer, "GlobalCounter requires an integer type");
+
+  public:
+    using value_type = T;
+
+    /**
+     * @brief Creates a counter with `shards` shards, each initialized to `initial`.
+     *
+     * @param comm The communicator to create the counter over
+     * @param initial The initial value of every shard
+     * @param shards The number of shards, between 1 and `comm.size()`
+     */
+    template <typename From>
+    explicit GlobalCounter(trait::Deref<From, Comm> &comm, T initial = 0, rank_t shards = 1)
+        : rank_(comm.deref().rank()),
+          size_(comm.deref().size()),
+          shards_(checked_shards(shards, size_)),
+          win_(UniqueWin<T>::allocate(comm, owns_shard() ? 1 : 0)) {
+        if (owns_shard()) {
+            win_[0] = initial;
+        }
+
+        win_.lock_all(WinLockAssertFlags::NoCheck);
+        comm.deref().barrier();
+    }
+
+    GlobalCounter(GlobalCounter &&) = default;
+    GlobalCounter &operator=(GlobalCounter &&) = delete;
+
+    ~GlobalCounter() {
+        if (win_) {
+            win_.unlock_all();
+        }
+    }
+
+    /**
+     * @brief Number of shards the counter is split across.
+     */
+    rank_t shards() const { return shards_; }
+
+    /**
+     * @brief The shard targeted by `fetch_add(value)` on this rank.
+     */
+    rank_t home_shard() const { return shard_of(rank_); }
+
+    /**
+     * @brief Atomically adds `value` to the home shard.
+     *
+     * @return The value of the home shard before the addition.
+     */
+    T fetch_add(T value = 1) { return fetch_add(home_shard(), value); }
+
+    /**
+     * @brief Atomically adds `value` to `shard`.
+     *
+     * @return The value of `shard` before the addition.
+     */
+    T fetch_add(rank_t shard, T value) {
+        return win_.fetch_and_op(mpi::sum(), value, shard_owner(shard), 0);
+    }
+
+    /**
+     * @brief Atomically reads the value of `shard`.
+     */
+    T load(rank_t shard) { return win_.fetch_and_op(mpi::no_op(), T{}, shard_owner(shard), 0); }
+
+    /**
+     * @brief Atomically replaces the value of `shard`, returning its previous value.
+     */
+    T exchange(rank_t shard, T value) {
+        return win_.fetch_and_op(mpi::replace(), value, shard_owner(shard), 0);
+    }
+
+    /**
+     * @brief Atomically replaces the value of `shard` with `desired` if it equals `expected`.
+     *
+     * @return The value of `shard` before the operation.
+     */
+    T compare_exchange(rank_t shard, T expected, T desired) {
+        return win_.compare_and_swap(desired, expected, shard_owner(shard), 0);
+    }
+
+    /**
+     * @brief Reads the sum of all shards.
+     *
+     * @details
+     * Each shard is read atomically, but the shards are not read as a single atomic snapshot.
+     */
+    T sum() {
+        T total = 0;
+        for (rank_t shard = 0; shard < shards_; shard++) {
+            total += load(shard);
+        }
+        return total;
+    }
+
+  private:
+    // Ranks are split into `shards_` contiguous blocks; each block shares a home shard, which
+    // lives on the first rank of the block.
+    rank_t shard_owner(rank_t shard) const {
+        return static_cast<rank_t>((static_cast<std::int64_t>(shard) * size_ + shards_ - 1) /
+                                   shards_);
+    }
+
+    rank_t shard_of(rank_t rank) const {
+        return static_cast<rank_t>(static_cast<std::int64_t>(rank) * shards_ / size_);
+    }
+
+    bool owns_shard() const { return shard_owner(shard_of(rank_)) == rank_; }
+
+    static rank_t checked_shards(rank_t shards, rank_t size) {
+        if (shards < 1 || shards > size) {
+            throw std::out_of_range("GlobalCounter: shards must be between 1 and comm.size()");
+        }
+        return shards;
+    }
+
+    rank_t rank_;
+    rank_t size_;
+    rank_t shards_;
+    UniqueWin<T> win_;
+};
+} // namespace mpi
+
+#endif // MPI_COUNTER_HPP
@@ -14,7 +14,12 @@
 #include <stdint.h>
 
 #include <cstdint>
+#include <stdexcept>
 #include <type_traits>
+#include <vector>
+
+#include "exception.hpp"
+#include "handle.hpp"
 
 namespace mpi {
 using rank_t = int;
@@ -157,6 +162,90 @@ struct DatatypeTraits<double> : public internal::DatatypeTraitsImpl {
 
 template <typename T>
 static constexpr bool is_datatype_v = DatatypeTraits<T>::is_datatype;
+
+struct DatatypeHandleTraits {
+    using handle_t = MPI_Datatype;
+
+    static handle_t null() { return MPI_DATATYPE_NULL; }
+    static void destroy(handle_t &handle) { check_result(MPI_Type_free(&handle)); }
+
+    static bool is_system_handle(handle_t /*handle*/) { return false; }
+};
+
+/**
+ * @brief Owns a committed derived datatype, which is freed on destruction.
+ */
+class UniqueDatatype : public internal::UniqueHandle<DatatypeHandleTraits> {
+    explicit UniqueDatatype(MPI_Datatype datatype) : UniqueHandle(datatype) {}
+
+  public:
+    UniqueDatatype() = default;
+
+    UniqueDatatype(UniqueDatatype &&) = default;
+    UniqueDatatype &operator=(UniqueDatatype &&) = default;
+
+    /**
+     * @brief Creates a datatype of `count` consecutive `element`s, using MPI_Type_contiguous.
+     */
+    static UniqueDatatype contiguous(int count, MPI_Datatype element) {
+        UniqueDatatype datatype;
+        check_result(MPI_Type_contiguous(count, element, datatype.addressof()));
+        check_result(MPI_Type_commit(datatype.addressof()));
+        return datatype;
+    }
+
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    static UniqueDatatype contiguous(int count) {
+        return contiguous(count, DatatypeTraits<T>::mpi_datatype());
+    }
+
+    /**
+     * @brief Creates a datatype of `count` blocks of `block_length` `element`s, whose starts are
+     *  `stride` elements apart, using MPI_Type_vector.
+     */
+    static UniqueDatatype strided(int count, int block_length, int stride, MPI_Datatype element) {
+        UniqueDatatype datatype;
+        check_result(MPI_Type_vector(count, block_length, stride, element, datatype.addressof()));
+        check_result(MPI_Type_commit(datatype.addressof()));
+        return datatype;
+    }
+
+    /**
+     * @brief Creates a datatype of blocks of `lengths[i]` `element`s, each `displacements[i]`
+     *  bytes from the start, using MPI_Type_create_hindexed.
+     *
+     * @throws std::logic_error if `lengths` and `displacements` differ in size
+     */
+    static UniqueDatatype hindexed(std::vector<int> const &lengths,
+                                   std::vector<aint_t> const &displacements,
+                                   MPI_Datatype element) {
+        if (lengths.size() != displacements.size()) {
+            throw std::logic_error("hindexed requires a displacement for every block");
+        }
+
+        UniqueDatatype datatype;
+        check_result(MPI_Type_create_hindexed(static_cast<int>(lengths.size()),
+                                              lengths.data(),
+                                              displacements.data(),
+                                              element,
+                                              datatype.addressof()));
+        check_result(MPI_Type_commit(datatype.addressof()));
+        return datatype;
+    }
+
+    static UniqueDatatype from_handle(MPI_Datatype datatype) { return UniqueDatatype(datatype); }
+
+    MPI_Datatype datatype() const { return get_raw(); }
+
+    /**
+     * @brief The number of bytes of data in one element of the datatype.
+     */
+    int size() const {
+        int size;
+        check_result(MPI_Type_size(datatype(), &size));
+        return size;
+    }
+};
 } // namespace mpi
 
 #endif // MPI_DATATYPE_HPP
@@ -0,0 +1,341 @@
+/**
+ * @file file.hpp
+ *
+ * @brief Defines types for parallel file I/O with MPI_File.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+#ifndef MPI_FILE_HPP
+#define MPI_FILE_HPP
+
+#include "mpi_stub_out.h"
+
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include <nonstd/span.hpp>
+
+#include "comm.hpp"
+#include "datatype.hpp"
+#include "deref.hpp"
+#include "exception.hpp"
+#include "handle.hpp"
+#include "info.hpp"
+#include "request.hpp"
+#include "status.hpp"
+
+#if MPI_VERSION > 3 || (MPI_VERSION == 3 && MPI_SUBVERSION >= 1)
+#define MPI_CPP_HAS_NONBLOCKING_COLLECTIVE_IO 1
+#endif
+
+namespace mpi {
+/**
+ * @brief A position in a file, counted in elements of the current view.
+ */
+using offset_t = MPI_Offset;
+
+/**
+ * @brief How a file is opened. Combine flags with `|`.
+ */
+enum class FileMode : int {
+    ReadOnly = MPI_MODE_RDONLY,
+    ReadWrite = MPI_MODE_RDWR,
+    WriteOnly = MPI_MODE_WRONLY,
+    Create = MPI_MODE_CREATE,
+    /// Fail if the file already exists; only with Create
+    Exclusive = MPI_MODE_EXCL,
+    DeleteOnClose = MPI_MODE_DELETE_ON_CLOSE,
+    /// No other process or program will open the file at the same time
+    UniqueOpen = MPI_MODE_UNIQUE_OPEN,
+    Sequential = MPI_MODE_SEQUENTIAL,
+    Append = MPI_MODE_APPEND,
+};
+
+inline FileMode operator|(FileMode a, FileMode b) {
+    return static_cast<FileMode>(static_cast<int>(a) | static_cast<int>(b));
+}
+
+class File;
+class UniqueFile;
+
+struct FileHandleTraits {
+    using handle_t = MPI_File;
+
+    static handle_t null() { return MPI_FILE_NULL; }
+    static void destroy(handle_t &handle) { check_result(MPI_File_close(&handle)); }
+
+    static bool is_system_handle(handle_t /*handle*/) { return false; }
+};
+
+namespace internal {
+/**
+ * @brief The operations on an open file.
+ *
+ * @details
+ * Offsets are in units of the elementary type of the current view, which is a byte until
+ * `set_view` is called. The `_all` variants are collective over the processes that opened the
+ * file, which lets the implementation aggregate the accesses of all processes (collective
+ * buffering); prefer them when every process takes part.
+ *
+ * Immediate variants return a request, and the buffer must stay valid until it completes.
+ */
+template <typename ConcreteType>
+class FileImpl : public trait::Deref<ConcreteType, File> {
+  public:
+    MPI_File file() const { return static_cast<ConcreteType const *>(this)->get_raw(); }
+
+    /**
+     * @brief Gets the size of the file, in bytes.
+     */
+    offset_t size() const {
+        offset_t size;
+        check_result(MPI_File_get_size(file(), &size));
+        return size;
+    }
+
+    /**
+     * @brief Truncates or extends the file to `size` bytes. Collective.
+     */
+    void set_size(offset_t size) { check_result(MPI_File_set_size(file(), size)); }
+
+    /**
+     * @brief Flushes written data to the storage device. Collective.
+     */
+    void sync() { check_result(MPI_File_sync(file())); }
+
+    /**
+     * @brief Sets the view of this process to a sequence of `T`s starting `displacement` bytes into
+     *  the file. Collective.
+     *
+     * @details
+     * Offsets passed to reads and writes are then counted in `T`s from the displacement.
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    void set_view(offset_t displacement,
+                  std::string const &data_representation = "native",
+                  Info const &info = Info{}) {
+        auto const datatype = DatatypeTraits<T>::mpi_datatype();
+        set_view(displacement, datatype, datatype, data_representation, info);
+    }
+
+    /**
+     * @brief Sets the view of this process to the parts of the file selected by `filetype`, tiled
+     *  from `displacement` bytes into the file. Collective.
+     *
+     * @details
+     * Offsets are then counted in `T`s of the selected parts only, so a noncontiguous filetype
+     * lets each process access its scattered parts of the file with a single (collective) call.
+     * `filetype` must be built from `T`s, and may be freed once the view is set.
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    void set_view(offset_t displacement,
+                  UniqueDatatype const &filetype,
+                  std::string const &data_representation = "native",
+                  Info const &info = Info{}) {
+        set_view(displacement,
+                 DatatypeTraits<T>::mpi_datatype(),
+                 filetype.datatype(),
+                 data_representation,
+                 info);
+    }
+
+    /**
+     * @brief Sets the view of this process from raw elementary and file datatypes. Collective.
+     */
+    void set_view(offset_t displacement,
+                  MPI_Datatype etype,
+                  MPI_Datatype filetype,
+                  std::string const &data_representation = "native",
+                  Info const &info = Info{}) {
+        check_result(MPI_File_set_view(
+            file(), displacement, etype, filetype, data_representation.c_str(), info.info()));
+    }
+
+    /**
+     * @brief Writes `data` at `offset`, independently of the other processes.
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    Status write_at(offset_t offset, nonstd::span<T const> data) {
+        MPI_Status status;
+        check_result(MPI_File_write_at(file(),
+                                       offset,
+                                       data.data(),
+                                       count_of(data.size()),
+                                       DatatypeTraits<T>::mpi_datatype(),
+                                       &status));
+        return Status(status);
+    }
+
+    /**
+     * @brief Writes `data` at `offset`. Collective.
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    Status write_at_all(offset_t offset, nonstd::span<T const> data) {
+        MPI_Status status;
+        check_result(MPI_File_write_at_all(file(),
+                                           offset,
+                                           data.data(),
+                                           count_of(data.size()),
+                                           DatatypeTraits<T>::mpi_datatype(),
+                                           &status));
+        return Status(status);
+    }
+
+    /**
+     * @brief Reads into `data` from `offset`, independently of the other processes.
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    Status read_at(offset_t offset, nonstd::span<T> data) {
+        MPI_Status status;
+        check_result(MPI_File_read_at(file(),
+                                      offset,
+                                      data.data(),
+                                      count_of(data.size()),
+                                      DatatypeTraits<T>::mpi_datatype(),
+                                      &status));
+        return Status(status);
+    }
+
+    /**
+     * @brief Reads into `data` from `offset`. Collective.
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    Status read_at_all(offset_t offset, nonstd::span<T> data) {
+        MPI_Status status;
+        check_result(MPI_File_read_at_all(file(),
+                                          offset,
+                                          data.data(),
+                                          count_of(data.size()),
+                                          DatatypeTraits<T>::mpi_datatype(),
+                                          &status));
+        return Status(status);
+    }
+
+    /**
+     * @brief Initiates an independent write of `data` at `offset`.
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    UniqueRequest iwrite_at(offset_t offset, nonstd::span<T const> data) {
+        UniqueRequest request;
+        check_result(MPI_File_iwrite_at(file(),
+                                        offset,
+                                        data.data(),
+                                        count_of(data.size()),
+                                        DatatypeTraits<T>::mpi_datatype(),
+                                        request.addressof()));
+        return request;
+    }
+
+    /**
+     * @brief Initiates an independent read into `data` from `offset`.
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    UniqueRequest iread_at(offset_t offset, nonstd::span<T> data) {
+        UniqueRequest request;
+        check_result(MPI_File_iread_at(file(),
+                                       offset,
+                                       data.data(),
+                                       count_of(data.size()),
+                                       DatatypeTraits<T>::mpi_datatype(),
+                                       request.addressof()));
+        return request;
+    }
+
+#ifdef MPI_CPP_HAS_NONBLOCKING_COLLECTIVE_IO
+    /**
+     * @brief Initiates a collective write of `data` at `offset`. Requires MPI 3.1.
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    UniqueRequest iwrite_at_all(offset_t offset, nonstd::span<T const> data) {
+        UniqueRequest request;
+        check_result(MPI_File_iwrite_at_all(file(),
+                                            offset,
+                                            data.data(),
+                                            count_of(data.size()),
+                                            DatatypeTraits<T>::mpi_datatype(),
+                                            request.addressof()));
+        return request;
+    }
+
+    /**
+     * @brief Initiates a collective read into `data` from `offset`. Requires MPI 3.1.
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    UniqueRequest iread_at_all(offset_t offset, nonstd::span<T> data) {
+        UniqueRequest request;
+        check_result(MPI_File_iread_at_all(file(),
+                                           offset,
+                                           data.data(),
+                                           count_of(data.size()),
+                                           DatatypeTraits<T>::mpi_datatype(),
+                                           request.addressof()));
+        return request;
+    }
+#endif
+
+  private:
+    static int count_of(std::size_t size) {
+        if (size > static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+            throw std::out_of_range("file access is too large");
+        }
+        return static_cast<int>(size);
+    }
+};
+} // namespace internal
+
+class File : public internal::Handle<FileHandleTraits>, public internal::FileImpl<File> {
+    explicit File(MPI_File file) : Handle(file) {}
+
+  public:
+    File() = default;
+
+    static File from_handle(MPI_File file) { return File(file); }
+};
+
+static_assert(sizeof(File) == sizeof(MPI_File), "File is expected to be the same size as MPI_File");
+
+/**
+ * @brief An open file, which is closed (collectively) on destruction.
+ */
+class UniqueFile : public internal::UniqueHandle<FileHandleTraits>,
+                   public internal::FileImpl<UniqueFile> {
+    explicit UniqueFile(MPI_File file) : UniqueHandle(file) {}
+
+  public:
+    UniqueFile() = default;
+
+    UniqueFile(UniqueFile &&) = default;
+    UniqueFile &operator=(UniqueFile &&) = default;
+
+    /**
+     * @brief Opens a file on every process of `comm`. Collective over `comm`.
+     *
+     * @param info Hints for the implementation, such as collective buffering settings
+     */
+    template <typename From>
+    static UniqueFile open(trait::Deref<From, Comm> const &comm,
+                           std::string const &filename,
+                           FileMode mode,
+                           Info const &info = Info{}) {
+        MPI_File file;
+        check_result(MPI_File_open(
+            comm.deref().comm(), filename.c_str(), static_cast<int>(mode), info.info(), &file));
+        return UniqueFile(file);
+    }
+
+    /**
+     * @brief Deletes a file that is not open.
+     */
+    static void delete_file(std::string const &filename, Info const &info = Info{}) {
+        check_result(MPI_File_delete(filename.c_str(), info.info()));
+    }
+
+    static UniqueFile from_handle(MPI_File file) { return UniqueFile(file); }
+};
+} // namespace mpi
+
+#endif // MPI_FILE_HPP
@@ -0,0 +1,470 @@
+/**
+ * @file future.hpp
+ *
+ * @brief Defines a composable future type for the results of non-blocking MPI operations.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+#ifndef MPI_FUTURE_HPP
+#define MPI_FUTURE_HPP
+
+#include "mpi_stub_out.h"
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "request.hpp"
+
+namespace mpi {
+template <typename T>
+class Future;
+
+/**
+ * @brief Stands in for the result of a `void` future in a tuple from `when_all`.
+ */
+struct VoidResult {};
+
+namespace internal {
+/**
+ * @brief The type-erased producer behind a Future.
+ */
+template <typename T>
+class FutureState {
+  public:
+    virtual ~FutureState() = default;
+
+    /**
+     * @brief Makes progress without blocking.
+     *
+     * @return True once the value is available.
+     */
+    virtual bool test() = 0;
+
+    /**
+     * @brief Blocks until the value is available.
+     */
+    virtual void wait() = 0;
+
+    /**
+     * @brief Moves the value out. Only called once, after `test()` returned true or `wait()`
+     *  returned.
+     */
+    virtual T take() = 0;
+};
+
+template <typename T>
+class ReadyState : public FutureState<T> {
+  public:
+    explicit ReadyState(T value) : value_(std::move(value)) {}
+
+    bool test() override { return true; }
+    void wait() override {}
+    T take() override { return std::move(value_); }
+
+  private:
+    T value_;
+};
+
+template <>
+class ReadyState<void> : public FutureState<void> {
+  public:
+    bool test() override { return true; }
+    void wait() override {}
+    void take() override {}
+};
+
+template <typename T, typename Storage>
+struct StorageResult {
+    static T take(Storage &storage) { return std::move(storage); }
+};
+
+template <typename Storage>
+struct StorageResult<void, Storage> {
+    static void take(Storage &) {}
+};
+
+/**
+ * @brief Owns a request along with the buffer that it reads from or writes to.
+ *
+ * @details
+ * States are always heap allocated and never moved, so `storage()` has a stable address that can
+ * be handed to a non-blocking MPI routine. If the state is destroyed while the request is still
+ * active, the destructor waits for the request so that the buffer is not freed out from under MPI.
+ *
+ * @tparam T The value the future produces - either `Storage` or `void`
+ * @tparam Storage The buffer the request operates on
+ */
+template <typename T, typename Storage = T>
+class RequestState : public FutureState<T> {
+  public:
+    template <typename... Args>
+    explicit RequestState(Args &&... args) : storage_(std::forward<Args>(args)...) {}
+
+    ~RequestState() override {
+        if (request_) {
+            request_.wait();
+        }
+    }
+
+    UniqueRequest &request() { return request_; }
+    Storage &storage() { return storage_; }
+
+    bool test() override { return request_.test(); }
+    void wait() override { request_.wait(); }
+    T take() override { return StorageResult<T, Storage>::take(storage_); }
+
+  private:
+    UniqueRequest request_;
+    Storage storage_;
+};
+
+template <typename U>
+struct ContinuationInvoker {
+    template <typename F>
+    static auto invoke(F &f, Future<U> &parent) -> decltype(f(std::declval<U>())) {
+        return f(parent.get());
+    }
+};
+
+template <>
+struct ContinuationInvoker<void> {
+    // Parent is always Future<void>, but is a template parameter so that Future may be incomplete.
+    template <typename F, typename Parent>
+    static auto invoke(F &f, Parent &parent) -> decltype(f()) {
+        parent.get();
+        return f();
+    }
+};
+
+template <typename R>
+struct ContinuationResult {
+    using value_type = R;
+
+    template <typename U, typename F>
+    static std::unique_ptr<FutureState<R>> run(F &f, Future<U> &parent) {
+        return std::make_unique<ReadyState<R>>(ContinuationInvoker<U>::invoke(f, parent));
+    }
+};
+
+template <>
+struct ContinuationResult<void> {
+    using value_type = void;
+
+    template <typename U, typename F>
+    static std::unique_ptr<FutureState<void>> run(F &f, Future<U> &parent) {
+        ContinuationInvoker<U>::invoke(f, parent);
+        return std::make_unique<ReadyState<void>>();
+    }
+};
+
+// Continuations that return a Future are flattened, so `then` never produces a Future<Future<T>>.
+template <typename V>
+struct ContinuationResult<Future<V>> {
+    using value_type = V;
+
+    template <typename U, typename F>
+    static std::unique_ptr<FutureState<V>> run(F &f, Future<U> &parent) {
+        return ContinuationInvoker<U>::invoke(f, parent).into_state();
+    }
+};
+
+template <typename U, typename F>
+using continuation_result_t =
+    decltype(ContinuationInvoker<U>::invoke(std::declval<F &>(), std::declval<Future<U> &>()));
+
+/**
+ * @brief Runs `f` on the value of `parent` once it is available, then produces the result of `f`.
+ */
+template <typename T, typename U, typename F>
+class ThenState : public FutureState<T> {
+  public:
+    ThenState(Future<U> &&parent, F &&f) : parent_(std::move(parent)), f_(std::move(f)) {}
+
+    bool test() override {
+        if (!next_) {
+            if (!parent_.test()) {
+                return false;
+            }
+            next_ = ContinuationResult<continuation_result_t<U, F>>::run(f_, parent_);
+        }
+
+        return next_->test();
+    }
+
+    void wait() override {
+        if (!next_) {
+            parent_.wait();
+            next_ = ContinuationResult<continuation_result_t<U, F>>::run(f_, parent_);
+        }
+
+        next_->wait();
+    }
+
+    T take() override { return next_->take(); }
+
+  private:
+    Future<U> parent_;
+    F f_;
+    std::unique_ptr<FutureState<T>> next_;
+};
+
+template <typename T>
+struct WhenAllResult {
+    using type = std::vector<T>;
+
+    static type collect(std::vector<Future<T>> &futures) {
+        type values;
+        values.reserve(futures.size());
+        for (auto &f : futures) {
+            values.push_back(f.get());
+        }
+        return values;
+    }
+};
+
+template <>
+struct WhenAllResult<void> {
+    using type = void;
+
+    template <typename Futures>
+    static void collect(Futures &futures) {
+        for (auto &f : futures) {
+            f.get();
+        }
+    }
+};
+
+template <typename T>
+class WhenAllState : public FutureState<typename WhenAllResult<T>::type> {
+  public:
+    explicit WhenAllState(std::vector<Future<T>> &&futures) : futures_(std::move(futures)) {}
+
+    bool test() override {
+        // Test every future, not just the first pending one, so they all make progress.
+        bool ready = true;
+        for (auto &f : futures_) {
+            ready = f.test() && ready;
+        }
+        return ready;
+    }
+
+    void wait() override {
+        for (auto &f : futures_) {
+            f.wait();
+        }
+    }
+
+    typename WhenAllResult<T>::type take() override { return WhenAllResult<T>::collect(futures_); }
+
+  private:
+    std::vector<Future<T>> futures_;
+};
+
+/**
+ * @brief The tuple element for a future's result, with `void` mapped to VoidResult.
+ */
+template <typename T>
+struct TupleResult {
+    using type = T;
+
+    static T take(Future<T> &future) { return future.get(); }
+};
+
+template <>
+struct TupleResult<void> {
+    using type = VoidResult;
+
+    // A template, since Future is still incomplete here.
+    template <typename F>
+    static VoidResult take(F &future) {
+        future.get();
+        return {};
+    }
+};
+
+template <typename T>
+using tuple_result_t = typename TupleResult<T>::type;
+
+template <typename... Ts>
+class WhenAllTupleState : public FutureState<std::tuple<tuple_result_t<Ts>...>> {
+  public:
+    explicit WhenAllTupleState(Future<Ts> &&... futures) : futures_(std::move(futures)...) {}
+
+    bool test() override { return test(std::index_sequence_for<Ts...>{}); }
+    void wait() override { wait(std::index_sequence_for<Ts...>{}); }
+    std::tuple<tuple_result_t<Ts>...> take() override {
+        return take(std::index_sequence_for<Ts...>{});
+    }
+
+  private:
+    template <std::size_t... Is>
+    bool test(std::index_sequence<Is...>) {
+        bool ready = true;
+        (void)std::initializer_list<int>{(ready = std::get<Is>(futures_).test() && ready, 0)...};
+        return ready;
+    }
+
+    template <std::size_t... Is>
+    void wait(std::index_sequence<Is...>) {
+        (void)std::initializer_list<int>{(std::get<Is>(futures_).wait(), 0)...};
+    }
+
+    template <std::size_t... Is>
+    std::tuple<tuple_result_t<Ts>...> take(std::index_sequence<Is...>) {
+        return std::tuple<tuple_result_t<Ts>...>(
+            TupleResult<Ts>::take(std::get<Is>(futures_))...);
+    }
+
+    std::tuple<Future<Ts>...> futures_;
+};
+} // namespace internal
+
+/**
+ * @brief The eventual result of a non-blocking operation.
+ *
+ * @details
+ * Unlike UniqueRequest, a Future owns the buffers used by its operation and may be dropped before
+ * the operation completes, in which case the destructor waits for completion. Futures are driven by
+ * polling - `test()` makes progress without blocking, while `get()` blocks until the value is
+ * available. Continuations attached with `then()` run on the thread that polls the future.
+ *
+ * @tparam T The type of the result, or `void` if the operation produces no value.
+ */
+template <typename T>
+class Future {
+  public:
+    using value_type = T;
+
+    Future() = default;
+    explicit Future(std::unique_ptr<internal::FutureState<T>> state) : state_(std::move(state)) {}
+
+    Future(Future &&) = default;
+    Future &operator=(Future &&) = default;
+
+    /**
+     * @brief Whether the future refers to a result that hasn't been retrieved with `get()`.
+     */
+    bool valid() const { return state_ != nullptr; }
+
+    /**
+     * @brief Makes progress on the operation without blocking.
+     *
+     * @return True if the result is available.
+     *
+     * @throws Exception
+     */
+    bool test() {
+        check_valid();
+        return state_->test();
+    }
+
+    /**
+     * @brief Blocks until the result is available.
+     *
+     * @throws Exception
+     */
+    void wait() {
+        check_valid();
+        state_->wait();
+    }
+
+    /**
+     * @brief Blocks until the result is available, then moves it out of the future. The future is
+     *  no longer valid afterwards.
+     *
+     * @throws Exception
+     */
+    T get() {
+        wait();
+        auto state = std::move(state_);
+        return state->take();
+    }
+
+    /**
+     * @brief Attaches a continuation to the future.
+     *
+     * @details
+     * `f` is called with the result of this future (or with no arguments if `T` is `void`) the
+     * first time the returned future is polled after this one completes. If `f` returns a Future,
+     * the returned future completes when that future does.
+     *
+     * @return A future for the result of `f`. This future is no longer valid.
+     */
+    template <typename F>
+    auto then(F &&f) -> Future<
+        typename internal::ContinuationResult<internal::continuation_result_t<T, std::decay_t<F>>>::
+            value_type> {
+        using R = typename internal::ContinuationResult<
+            internal::continuation_result_t<T, std::decay_t<F>>>::value_type;
+
+        check_valid();
+        return Future<R>(std::make_unique<internal::ThenState<R, T, std::decay_t<F>>>(
+            std::move(*this), std::decay_t<F>(std::forward<F>(f))));
+    }
+
+    /**
+     * @brief Releases the state driving this future, to be adopted by another future.
+     */
+    std::unique_ptr<internal::FutureState<T>> into_state() {
+        check_valid();
+        return std::move(state_);
+    }
+
+  private:
+    void check_valid() const {
+        if (!state_) {
+            throw std::logic_error("mpi::Future has no state");
+        }
+    }
+
+    std::unique_ptr<internal::FutureState<T>> state_;
+};
+
+/**
+ * @brief Creates a future that is already complete with `value`.
+ */
+template <typename T>
+Future<std::decay_t<T>> make_ready_future(T &&value) {
+    return Future<std::decay_t<T>>(
+        std::make_unique<internal::ReadyState<std::decay_t<T>>>(std::forward<T>(value)));
+}
+
+/**
+ * @brief Creates a `void` future that is already complete.
+ */
+inline Future<void> make_ready_future() {
+    return Future<void>(std::make_unique<internal::ReadyState<void>>());
+}
+
+/**
+ * @brief Combines a list of futures into a single future for all of their results.
+ *
+ * @return A future for the results, in the same order as `futures`. If `T` is `void`, the result
+ *  is also `void`.
+ */
+template <typename T>
+Future<typename internal::WhenAllResult<T>::type> when_all(std::vector<Future<T>> futures) {
+    return Future<typename internal::WhenAllResult<T>::type>(
+        std::make_unique<internal::WhenAllState<T>>(std::move(futures)));
+}
+
+/**
+ * @brief Combines futures of different types into a single future for a tuple of their results.
+ *
+ * @details The results of `void` futures appear in the tuple as VoidResult.
+ */
+template <typename... Ts>
+Future<std::tuple<internal::tuple_result_t<Ts>...>> when_all(Future<Ts>... futures) {
+    return Future<std::tuple<internal::tuple_result_t<Ts>...>>(
+        std::make_unique<internal::WhenAllTupleState<Ts...>>(std::move(futures)...));
+}
+} // namespace mpi
+
+#endif // MPI_FUTURE_HPP
@@ -13,10 +13,16 @@
 #include "mpi_stub_out.h"
 
 #include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
 #include <nonstd/span.hpp>
 
 #include "datatype.hpp"
 #include "exception.hpp"
+#include "deref.hpp"
 #include "handle.hpp"
 
 namespace mpi {
@@ -44,6 +50,56 @@ static_assert(offsetof(GroupRange, first) == 0, "first must be 0-offset");
 static_assert(offsetof(GroupRange, last) == sizeof(int), "first must be 1-offset");
 static_assert(offsetof(GroupRange, stride) == sizeof(int) * 2, "first must be 2-offset");
 
+/**
+ * @brief The result of comparing two groups.
+ */
+enum class GroupComparison {
+    /// The same processes in the same order
+    Identical = MPI_IDENT,
+    /// The same processes in a different order
+    Similar = MPI_SIMILAR,
+    /// Different processes
+    Unequal = MPI_UNEQUAL,
+};
+
+/**
+ * @brief A precomputed mapping from the ranks of one group to the ranks of another.
+ *
+ * @details
+ * Built with a single MPI_Group_translate_ranks call, after which each lookup is an array index.
+ * Ranks without a counterpart in the target group map to MPI_UNDEFINED.
+ */
+class RankTranslation {
+  public:
+    RankTranslation() = default;
+    explicit RankTranslation(std::vector<rank_t> table) : table_(std::move(table)) {}
+
+    /**
+     * @brief The rank in the target group of `rank` in the source group.
+     */
+    rank_t operator[](rank_t rank) const { return table_[rank]; }
+
+    /**
+     * @brief Like `operator[]`, with bounds checking.
+     */
+    rank_t at(rank_t rank) const {
+        if (rank < 0 || static_cast<std::size_t>(rank) >= table_.size()) {
+            throw std::out_of_range("rank is not in the source group");
+        }
+        return table_[rank];
+    }
+
+    /**
+     * @brief The size of the source group.
+     */
+    std::size_t size() const { return table_.size(); }
+
+    std::vector<rank_t> const &table() const { return table_; }
+
+  private:
+    std::vector<rank_t> table_;
+};
+
 namespace internal {
 template <typename ConcreteType>
 class GroupImpl : public trait::Deref<ConcreteType, Group> {
@@ -58,7 +114,78 @@ class GroupImpl : public trait::Deref<ConcreteType, Group> {
     UniqueGroup range_excl(GroupRange &range) const;
     UniqueGroup range_excl(rank_t from, rank_t to) const;
 
+    UniqueGroup incl(nonstd::span<rank_t const> ranks) const;
+    UniqueGroup excl(nonstd::span<rank_t const> ranks) const;
+
+    template <typename From>
+    UniqueGroup union_with(trait::Deref<From, Group> const &other) const;
+
+    template <typename From>
+    UniqueGroup intersection(trait::Deref<From, Group> const &other) const;
+
+    template <typename From>
+    UniqueGroup difference(trait::Deref<From, Group> const &other) const;
+
     bool is_empty() const { return group() == MPI_GROUP_EMPTY; }
+
+    /**
+     * @brief Gets the number of processes in the group.
+     */
+    rank_t size() const {
+        int size;
+        check_result(MPI_Group_size(group(), &size));
+        return size;
+    }
+
+    /**
+     * @brief Gets the rank of the local process in the group, or MPI_UNDEFINED if it is not a
+     *  member.
+     */
+    rank_t rank() const {
+        int rank;
+        check_result(MPI_Group_rank(group(), &rank));
+        return rank;
+    }
+
+    template <typename From>
+    GroupComparison compare(trait::Deref<From, Group> const &other) const {
+        int result;
+        check_result(MPI_Group_compare(group(), other.deref().group(), &result));
+        return static_cast<GroupComparison>(result);
+    }
+
+    /**
+     * @brief Translates ranks in this group to the ranks of the same processes in `to`.
+     *
+     * @return The rank in `to` of each of `ranks`, or MPI_UNDEFINED for processes not in `to`.
+     */
+    template <typename From>
+    std::vector<rank_t> translate_ranks(nonstd::span<rank_t const> ranks,
+                                        trait::Deref<From, Group> const &to) const {
+        if (ranks.size() > std::numeric_limits<int>::max()) {
+            throw std::out_of_range("ranks array is too large");
+        }
+
+        std::vector<rank_t> translated(ranks.size());
+        check_result(MPI_Group_translate_ranks(group(),
+                                               static_cast<int>(ranks.size()),
+                                               ranks.data(),
+                                               to.deref().group(),
+                                               translated.data()));
+        return translated;
+    }
+
+    /**
+     * @brief Translates every rank in this group to `to` at once, for repeated lookups.
+     */
+    template <typename From>
+    RankTranslation translate_ranks(trait::Deref<From, Group> const &to) const {
+        std::vector<rank_t> ranks(size());
+        for (rank_t r = 0; r < static_cast<rank_t>(ranks.size()); r++) {
+            ranks[r] = r;
+        }
+        return RankTranslation(translate_ranks(nonstd::span<rank_t const>(ranks), to));
+    }
 };
 } // namespace internal
 
@@ -66,9 +193,18 @@ struct GroupHandleTraits {
     using handle_t = MPI_Group;
 
     static handle_t null() { return MPI_GROUP_NULL; }
-    static void destroy(handle_t &handle) { check_result(MPI_Group_free(&handle)); }
 
-    static bool is_system_handle(handle_t handle) { return handle == MPI_GROUP_EMPTY; }
+    // Group constructors and set operations return MPI_GROUP_EMPTY for empty results, so a
+    // UniqueGroup may own it even though it is predefined. It is never freed.
+    static void destroy(handle_t &handle) {
+        if (handle == MPI_GROUP_EMPTY) {
+            handle = MPI_GROUP_NULL;
+        } else {
+            check_result(MPI_Group_free(&handle));
+        }
+    }
+
+    static bool is_system_handle(handle_t /*handle*/) { return false; }
 };
 
 class Group : public internal::Handle<GroupHandleTraits>, public internal::GroupImpl<Group> {
@@ -150,6 +286,57 @@ UniqueGroup internal::GroupImpl<ConcreteType>::range_excl(rank_t from, rank_t to
     auto range = GroupRange::unit_stride(from, to);
     return range_excl(range);
 }
+
+template <typename ConcreteType>
+UniqueGroup internal::GroupImpl<ConcreteType>::incl(nonstd::span<rank_t const> ranks) const {
+    if (ranks.size() > std::numeric_limits<int>::max()) {
+        throw std::out_of_range("ranks array is too large");
+    }
+
+    UniqueGroup g;
+    check_result(
+        MPI_Group_incl(group(), static_cast<int>(ranks.size()), ranks.data(), g.addressof()));
+    return g;
+}
+
+template <typename ConcreteType>
+UniqueGroup internal::GroupImpl<ConcreteType>::excl(nonstd::span<rank_t const> ranks) const {
+    if (ranks.size() > std::numeric_limits<int>::max()) {
+        throw std::out_of_range("ranks array is too large");
+    }
+
+    UniqueGroup g;
+    check_result(
+        MPI_Group_excl(group(), static_cast<int>(ranks.size()), ranks.data(), g.addressof()));
+    return g;
+}
+
+template <typename ConcreteType>
+template <typename From>
+UniqueGroup
+internal::GroupImpl<ConcreteType>::union_with(trait::Deref<From, Group> const &other) const {
+    UniqueGroup g;
+    check_result(MPI_Group_union(group(), other.deref().group(), g.addressof()));
+    return g;
+}
+
+template <typename ConcreteType>
+template <typename From>
+UniqueGroup
+internal::GroupImpl<ConcreteType>::intersection(trait::Deref<From, Group> const &other) const {
+    UniqueGroup g;
+    check_result(MPI_Group_intersection(group(), other.deref().group(), g.addressof()));
+    return g;
+}
+
+template <typename ConcreteType>
+template <typename From>
+UniqueGroup
+internal::GroupImpl<ConcreteType>::difference(trait::Deref<From, Group> const &other) const {
+    UniqueGroup g;
+    check_result(MPI_Group_difference(group(), other.deref().group(), g.addressof()));
+    return g;
+}
 } // namespace mpi
 
 #endif // MPI_GROUP_HPP
\ No newline at end of file
@@ -0,0 +1,259 @@
+/**
+ * @file info.hpp
+ *
+ * @brief Defines types for passing hints to MPI.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+#ifndef MPI_INFO_HPP
+#define MPI_INFO_HPP
+
+#include "mpi_stub_out.h"
+
+#include <string>
+#include <vector>
+
+#include <nonstd/optional.hpp>
+
+#include "deref.hpp"
+#include "exception.hpp"
+#include "handle.hpp"
+
+namespace mpi {
+class Info;
+class UniqueInfo;
+
+struct InfoHandleTraits {
+    using handle_t = MPI_Info;
+
+    static handle_t null() { return MPI_INFO_NULL; }
+    static void destroy(handle_t &handle) { check_result(MPI_Info_free(&handle)); }
+
+    static bool is_system_handle(handle_t /*handle*/) { return false; }
+};
+
+namespace internal {
+/**
+ * @brief The operations on a set of (key, value) hints. A null Info has no keys, and cannot be
+ *  modified.
+ */
+template <typename ConcreteType>
+class InfoImpl : public trait::Deref<ConcreteType, Info> {
+  public:
+    MPI_Info info() const { return static_cast<ConcreteType const *>(this)->get_raw(); }
+
+    void set(std::string const &key, std::string const &value) {
+        check_result(MPI_Info_set(info(), key.c_str(), value.c_str()));
+    }
+
+    /**
+     * @brief Gets the value of `key`, if it is set.
+     */
+    nonstd::optional<std::string> get(std::string const &key) const {
+        if (info() == MPI_INFO_NULL) {
+            return nonstd::nullopt;
+        }
+
+        int length;
+        int flag;
+        check_result(MPI_Info_get_valuelen(info(), key.c_str(), &length, &flag));
+        if (!flag) {
+            return nonstd::nullopt;
+        }
+
+        std::vector<char> value(length + 1);
+        check_result(MPI_Info_get(info(), key.c_str(), length, value.data(), &flag));
+        return std::string(value.data(), length);
+    }
+
+    /**
+     * @brief Removes `key`.
+     *
+     * @return Whether `key` was set.
+     */
+    bool erase(std::string const &key) {
+        if (!get(key)) {
+            return false;
+        }
+
+        check_result(MPI_Info_delete(info(), key.c_str()));
+        return true;
+    }
+
+    /**
+     * @brief Gets the number of keys that are set.
+     */
+    int nkeys() const {
+        if (info() == MPI_INFO_NULL) {
+            return 0;
+        }
+
+        int nkeys;
+        check_result(MPI_Info_get_nkeys(info(), &nkeys));
+        return nkeys;
+    }
+
+    /**
+     * @brief Gets the `n`th key, for `n` in `[0, nkeys())`.
+     */
+    std::string nth_key(int n) const {
+        char key[MPI_MAX_INFO_KEY + 1];
+        check_result(MPI_Info_get_nthkey(info(), n, key));
+        return key;
+    }
+
+    UniqueInfo dup() const;
+};
+} // namespace internal
+
+class Info : public internal::Handle<InfoHandleTraits>, public internal::InfoImpl<Info> {
+    explicit Info(MPI_Info info) : Handle(info) {}
+
+  public:
+    /**
+     * @brief A null Info, which passes no hints.
+     */
+    Info() = default;
+
+    static Info from_handle(MPI_Info info) { return Info(info); }
+};
+
+static_assert(sizeof(Info) == sizeof(MPI_Info), "Info is expected to be the same size as MPI_Info");
+
+class UniqueInfo : public internal::UniqueHandle<InfoHandleTraits>,
+                   public internal::InfoImpl<UniqueInfo> {
+    explicit UniqueInfo(MPI_Info info) : UniqueHandle(info) {}
+
+  public:
+    UniqueInfo() = default;
+
+    UniqueInfo(UniqueInfo &&) = default;
+    UniqueInfo &operator=(UniqueInfo &&) = default;
+
+    /**
+     * @brief Creates an empty set of hints.
+     */
+    static UniqueInfo create() {
+        UniqueInfo info;
+        check_result(MPI_Info_create(info.addressof()));
+        return info;
+    }
+
+    static UniqueInfo from_handle(MPI_Info info) { return UniqueInfo(info); }
+
+    /**
+     * @brief Lends the hints to functions that take an `Info`.
+     */
+    operator Info() const { return deref(); }
+};
+
+template <typename ConcreteType>
+UniqueInfo internal::InfoImpl<ConcreteType>::dup() const {
+    UniqueInfo copy;
+    if (info() != MPI_INFO_NULL) {
+        check_result(MPI_Info_dup(info(), copy.addressof()));
+    }
+    return copy;
+}
+
+/**
+ * @brief Builds a set of hints, with typed setters for the hints that are reserved by the MPI
+ *  standard or widely recognized.
+ *
+ * @details
+ * Implementations ignore hints they do not understand, so a hint is never an error, but may have
+ * no effect.
+ *
+ * @code
+ * auto info = mpi::InfoBuilder().no_locks().accumulate_ordering("none").build();
+ * auto win = mpi::UniqueWin<double>::allocate(comm, count, info);
+ * @endcode
+ */
+class InfoBuilder {
+  public:
+    InfoBuilder() : info_(UniqueInfo::create()) {}
+
+    InfoBuilder &set(std::string const &key, std::string const &value) {
+        info_.set(key, value);
+        return *this;
+    }
+
+    // Window hints
+
+    /// The window is never locked, so passive target synchronization need not be supported.
+    InfoBuilder &no_locks(bool value = true) { return set_bool("no_locks", value); }
+
+    /// The orderings accumulates must keep, as a comma-separated subset of "rar,raw,war,waw", or
+    /// "none".
+    InfoBuilder &accumulate_ordering(std::string const &orderings) {
+        return set("accumulate_ordering", orderings);
+    }
+
+    /// Concurrent accumulates to the same location use the same op ("same_op"), or that op and
+    /// MPI_NO_OP ("same_op_no_op").
+    InfoBuilder &accumulate_ops(std::string const &ops) { return set("accumulate_ops", ops); }
+
+    /// Every process allocates a window of the same size.
+    InfoBuilder &same_size(bool value = true) { return set_bool("same_size", value); }
+
+    /// Every process uses the same displacement unit.
+    InfoBuilder &same_disp_unit(bool value = true) { return set_bool("same_disp_unit", value); }
+
+    // File hints
+
+    /// The number of processes that aggregate data for collective I/O.
+    InfoBuilder &cb_nodes(int nodes) { return set("cb_nodes", std::to_string(nodes)); }
+
+    /// The size, in bytes, of the buffer each aggregator uses for collective I/O.
+    InfoBuilder &cb_buffer_size(int bytes) { return set("cb_buffer_size", std::to_string(bytes)); }
+
+    /// Whether collective I/O aggregates data on a subset of processes.
+    InfoBuilder &collective_buffering(bool value = true) {
+        return set_bool("collective_buffering", value);
+    }
+
+    /// The number of storage devices a new file is striped across.
+    InfoBuilder &striping_factor(int devices) {
+        return set("striping_factor", std::to_string(devices));
+    }
+
+    /// The size, in bytes, of each stripe of a new file.
+    InfoBuilder &striping_unit(int bytes) { return set("striping_unit", std::to_string(bytes)); }
+
+    /// How the file will be accessed, as a comma-separated list such as "write_once,sequential".
+    InfoBuilder &access_style(std::string const &style) { return set("access_style", style); }
+
+    // Communicator hints, which MPI 4 implementations may use to speed up matching
+
+    /// No receive on the communicator uses MPI_ANY_SOURCE.
+    InfoBuilder &no_any_source(bool value = true) {
+        return set_bool("mpi_assert_no_any_source", value);
+    }
+
+    /// No receive on the communicator uses MPI_ANY_TAG.
+    InfoBuilder &no_any_tag(bool value = true) { return set_bool("mpi_assert_no_any_tag", value); }
+
+    /// Every receive buffer has exactly the size of the message it matches.
+    InfoBuilder &exact_length(bool value = true) {
+        return set_bool("mpi_assert_exact_length", value);
+    }
+
+    /// Messages need not be matched in the order they were sent.
+    InfoBuilder &allow_overtaking(bool value = true) {
+        return set_bool("mpi_assert_allow_overtaking", value);
+    }
+
+    UniqueInfo build() { return std::move(info_); }
+
+  private:
+    InfoBuilder &set_bool(std::string const &key, bool value) {
+        return set(key, value ? "true" : "false");
+    }
+
+    UniqueInfo info_;
+};
+} // namespace mpi
+
+#endif // MPI_INFO_HPP
@@ -0,0 +1,97 @@
+/**
+ * @file memory.hpp
+ *
+ * @brief Defines routines and an STL allocator for allocating memory through MPI.
+ * @date 2026-10-16
+ *
+ * @details
+ * Memory from MPI_Alloc_mem may already be registered with the network, which lets some
+ * implementations send from and receive into it without copying or registering it on the fly.
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+#ifndef MPI_MEMORY_HPP
+#define MPI_MEMORY_HPP
+
+#include "mpi_stub_out.h"
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+#include "datatype.hpp"
+#include "exception.hpp"
+#include "info.hpp"
+
+namespace mpi {
+/**
+ * @brief Allocates `size` bytes using MPI_Alloc_mem.
+ *
+ * @param size The number of bytes to allocate
+ * @param info Implementation-specific hints, such as the kind of memory to allocate
+ * @return The allocated memory, which must be freed with `free_mem`.
+ *
+ * @throws Exception if MPI could not allocate the memory
+ */
+inline void *alloc_mem(std::size_t size, Info const &info = Info{}) {
+    if (size > static_cast<std::size_t>(std::numeric_limits<aint_t>::max())) {
+        throw std::out_of_range("allocation is too large for MPI_Alloc_mem");
+    }
+
+    void *memory;
+    check_result(MPI_Alloc_mem(static_cast<aint_t>(size), info.info(), &memory));
+    return memory;
+}
+
+/**
+ * @brief Frees memory allocated with `alloc_mem`.
+ */
+inline void free_mem(void *memory) { check_result(MPI_Free_mem(memory)); }
+
+/**
+ * @brief An STL allocator that allocates with MPI_Alloc_mem.
+ *
+ * @details
+ * MPI must stay initialized for as long as memory from the allocator is in use.
+ */
+template <typename T>
+class Allocator {
+  public:
+    using value_type = T;
+
+    Allocator() = default;
+
+    template <typename U>
+    Allocator(Allocator<U> const &) noexcept {}
+
+    T *allocate(std::size_t n) {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T *>(alloc_mem(n * sizeof(T)));
+    }
+
+    void deallocate(T *memory, std::size_t) { free_mem(memory); }
+};
+
+template <typename T, typename U>
+bool operator==(Allocator<T> const &, Allocator<U> const &) {
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(Allocator<T> const &, Allocator<U> const &) {
+    return false;
+}
+
+/**
+ * @brief A vector whose storage is allocated with MPI_Alloc_mem.
+ */
+template <typename T>
+using vector = std::vector<T, Allocator<T>>;
+} // namespace mpi
+
+#endif // MPI_MEMORY_HPP
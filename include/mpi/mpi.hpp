@@ -19,15 +19,33 @@
 #include <nonstd/optional.hpp>
 #include <nonstd/span.hpp>
 
+#include "active_messages.hpp"
+#include "aggregator.hpp"
+#include "algorithm.hpp"
+#include "buffer_pool.hpp"
+#include "checkpoint.hpp"
 #include "clock.hpp"
 #include "comm.hpp"
+#include "coroutine.hpp"
+#include "counter.hpp"
 #include "datatype.hpp"
 #include "exception.hpp"
+#include "file.hpp"
+#include "future.hpp"
 #include "group.hpp"
+#include "info.hpp"
+#include "memory.hpp"
 #include "op.hpp"
+#include "partitioned.hpp"
+#include "progress.hpp"
 #include "request.hpp"
+#include "request_set.hpp"
+#include "serialize.hpp"
 #include "status.hpp"
+#include "streaming_writer.hpp"
+#include "thread.hpp"
 #include "win.hpp"
+#include "work_queue.hpp"
 
 /**
  * @brief mpi is a library for writing massively parallel programs.
@@ -50,6 +68,23 @@ namespace trait {}
  */
 inline void init(int &argc, char **&argv) { check_result(MPI_Init(&argc, &argv)); }
 
+/**
+ * @brief Initializes the MPI library with support for threads. Must be called prior to calling any
+ *  other `mpi::` routines.
+ *
+ * @param argc The program's argument count
+ * @param argv The program's argument list
+ * @param required The desired level of thread support
+ * @return The level of thread support actually provided, which may be less than `required`.
+ *
+ * @throws Exception
+ */
+inline ThreadLevel init_thread(int &argc, char **&argv, ThreadLevel required) {
+    int provided;
+    check_result(MPI_Init_thread(&argc, &argv, static_cast<int>(required), &provided));
+    return static_cast<ThreadLevel>(provided);
+}
+
 /**
  * @brief Finalizes the MPI library. Must be called prior to calling any other `mpi::` routines.
  *
@@ -260,6 +295,204 @@ inline void wait_some_into(nonstd::span<UniqueRequest> requests, std::vector<int
     indices.resize(original_indices_size + num_completed);
 }
 
+/**
+ * @brief Tests if any request has completed, returning the index of that request and the status of
+ *  the completed request in the `status` out parameter.
+ *
+ * @param requests A list of requests.
+ * @param index Returns the index of the completed request, or MPI_UNDEFINED if none of the
+ *  requests were active.
+ * @param status Returns the status of the completed request.
+ * @return True if a request completed or none of the requests were active, otherwise false.
+ *
+ * @throws Exception
+ */
+inline bool test_any(nonstd::span<UniqueRequest> requests, int &index, Status &status) {
+    if (requests.size() > std::numeric_limits<int>::max()) {
+        throw std::out_of_range("requests array is too large");
+    }
+
+    int flag;
+    MPI_Status mpi_status;
+    check_result(MPI_Testany(static_cast<int>(requests.size()),
+                             reinterpret_cast<MPI_Request *>(requests.data()),
+                             &index,
+                             &flag,
+                             &mpi_status));
+
+    if (flag != 0) {
+        status = Status(mpi_status);
+    }
+
+    return flag != 0;
+}
+
+/**
+ * @brief Tests if any request has completed, returning the index of that request.
+ *
+ * @param requests A list of requests.
+ * @param index Returns the index of the completed request, or MPI_UNDEFINED if none of the
+ *  requests were active.
+ * @return True if a request completed or none of the requests were active, otherwise false.
+ *
+ * @throws Exception
+ */
+inline bool test_any(nonstd::span<UniqueRequest> requests, int &index) {
+    if (requests.size() > std::numeric_limits<int>::max()) {
+        throw std::out_of_range("requests array is too large");
+    }
+
+    int flag;
+    check_result(MPI_Testany(static_cast<int>(requests.size()),
+                             reinterpret_cast<MPI_Request *>(requests.data()),
+                             &index,
+                             &flag,
+                             MPI_STATUS_IGNORE));
+
+    return flag != 0;
+}
+
+/**
+ * @brief Tests if all requests have completed, returning in statuses the status of each completed
+ *  request. Either all of the requests are completed, or none of them are.
+ *
+ * @param requests A list of requests.
+ * @param statuses The status of each completed request. `statuses[i]` is the completion status for
+ *  `requests[i]`. Only written if all requests completed.
+ * @return True if all requests completed, otherwise false.
+ *
+ * @throws Exception
+ */
+inline bool test_all(nonstd::span<UniqueRequest> requests, nonstd::span<Status> statuses) {
+    if (requests.size() > std::numeric_limits<int>::max()) {
+        throw std::out_of_range("requests array is too large");
+    }
+
+    if (statuses.size() < requests.size()) {
+        throw std::logic_error(
+            "statuses array must be large enough to hold a status for each request");
+    }
+
+    int flag;
+    check_result(MPI_Testall(static_cast<int>(requests.size()),
+                             reinterpret_cast<MPI_Request *>(requests.data()),
+                             &flag,
+                             reinterpret_cast<MPI_Status *>(statuses.data())));
+
+    return flag != 0;
+}
+
+/**
+ * @brief Tests if all requests have completed. Either all of the requests are completed, or none
+ *  of them are.
+ *
+ * @param requests A list of requests.
+ * @return True if all requests completed, otherwise false.
+ *
+ * @throws Exception
+ */
+inline bool test_all(nonstd::span<UniqueRequest> requests) {
+    if (requests.size() > std::numeric_limits<int>::max()) {
+        throw std::out_of_range("requests array is too large");
+    }
+
+    int flag;
+    check_result(MPI_Testall(static_cast<int>(requests.size()),
+                             reinterpret_cast<MPI_Request *>(requests.data()),
+                             &flag,
+                             MPI_STATUSES_IGNORE));
+
+    return flag != 0;
+}
+
+/**
+ * @brief Completes every request that has already finished, without blocking.
+ *
+ * @param requests A list of requests. At least one must be active.
+ * @param indices The indices of each request that was completed.
+ * @param statuses The status for each request that is completed, parallel to indices.
+ * @return The number of completed requests, which may be 0.
+ *
+ * @throws Exception
+ */
+inline int test_some(nonstd::span<UniqueRequest> requests,
+                     nonstd::span<int> indices,
+                     nonstd::optional<nonstd::span<Status>> statuses = nonstd::nullopt) {
+    if (requests.size() > std::numeric_limits<int>::max()) {
+        throw std::out_of_range("requests array is too large");
+    }
+
+    if (indices.size() < requests.size()) {
+        throw std::logic_error(
+            "indices array must be large enough to hold an index for each request");
+    }
+
+    if (statuses) {
+        if (statuses->size() < requests.size()) {
+            throw std::logic_error(
+                "statuses array must be large enough to hold a status for each request");
+        }
+    }
+
+    MPI_Status *const statuses_data =
+        statuses ? reinterpret_cast<MPI_Status *>(statuses->data()) : MPI_STATUSES_IGNORE;
+
+    int num_completed;
+    check_result(MPI_Testsome(static_cast<int>(requests.size()),
+                              reinterpret_cast<MPI_Request *>(requests.data()),
+                              &num_completed,
+                              indices.data(),
+                              statuses_data));
+
+    if (num_completed == MPI_UNDEFINED) {
+        throw std::logic_error(
+            "mpi::test_some should only be called when there are still active requests");
+    }
+
+    return num_completed;
+}
+
+/**
+ * @brief Completes every request that has already finished, without blocking.
+ *
+ * @param requests A list of requests. At least one must be active.
+ * @param indices A vector that receives the index of each completed request. It is not cleared -
+ *  all new indices are appended to the end of the list.
+ * @return The number of indices appended to `indices`, which may be 0.
+ *
+ * @throws Exception
+ */
+inline int test_some_into(nonstd::span<UniqueRequest> requests, std::vector<int> &indices) {
+    auto const original_indices_size = indices.size();
+    // See wait_some_into - indices must have room for an index for every request.
+    indices.resize(original_indices_size + requests.size());
+
+    auto const num_completed =
+        test_some(requests, nonstd::span<int>{indices}.subspan(original_indices_size));
+
+    indices.resize(original_indices_size + num_completed);
+    return num_completed;
+}
+
+/**
+ * @brief Returns true if any request in the list is still active.
+ *
+ * @details
+ * Completed requests are set to MPI_REQUEST_NULL by the wait_* and test_* routines, so this is
+ * useful as the condition of a progress loop around `test_some`.
+ *
+ * @param requests A list of requests.
+ */
+inline bool any_active(nonstd::span<UniqueRequest const> requests) {
+    for (auto const &request : requests) {
+        if (request) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 /**
  * @brief Gets the current time of the MpiClock.
  *
@@ -28,7 +28,8 @@ struct OpHandleTraits {
         return (handle == MPI_MAX || handle == MPI_MIN || handle == MPI_SUM || handle == MPI_PROD ||
                 handle == MPI_LAND || handle == MPI_BAND || handle == MPI_LOR ||
                 handle == MPI_BOR || handle == MPI_LXOR || handle == MPI_BXOR ||
-                handle == MPI_MAXLOC || handle == MPI_MINLOC);
+                handle == MPI_MAXLOC || handle == MPI_MINLOC || handle == MPI_REPLACE ||
+                handle == MPI_NO_OP);
     }
 };
 
@@ -48,10 +49,25 @@ class Op : public internal::UniqueHandle<OpHandleTraits> {
         if (!OpTraits::is_user_defined) into_raw();
     }
 
-    static std::enable_if_t<!OpTraits::is_user_defined, Op> from_system_handle(MPI_Op op) {
+    template <typename Traits = OpTraits>
+    static std::enable_if_t<!Traits::is_user_defined, Op> from_system_handle(MPI_Op op) {
         return Op{op};
     }
 
+    /**
+     * @brief Creates an op from a function, using MPI_Op_create.
+     *
+     * @param function Combines `*len` elements of `in` into `inout`
+     * @param commutative Whether the function is commutative, which lets MPI reorder reductions
+     */
+    template <typename Traits = OpTraits>
+    static std::enable_if_t<Traits::is_user_defined, Op> create(MPI_User_function *function,
+                                                                bool commutative) {
+        Op op;
+        check_result(MPI_Op_create(function, commutative, op.addressof()));
+        return op;
+    }
+
     MPI_Op op() const { return get_raw(); }
 };
 
@@ -107,6 +123,34 @@ using BitwiseOp = Op<bitwise_op_traits>;
 inline BitwiseOp bitwise_and() { return BitwiseOp::from_system_handle(MPI_BAND); }
 inline BitwiseOp bitwise_or() { return BitwiseOp::from_system_handle(MPI_BOR); }
 inline BitwiseOp bitwise_xor() { return BitwiseOp::from_system_handle(MPI_BXOR); }
+
+/**
+ * @brief Operations that are only valid for one-sided accumulate routines, e.g. Win::fetch_and_op.
+ */
+struct rma_op_traits {
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    static constexpr bool is_applicable = true;
+
+    static constexpr bool is_user_defined = false;
+};
+
+using RmaOp = Op<rma_op_traits>;
+
+inline RmaOp replace() { return RmaOp::from_system_handle(MPI_REPLACE); }
+inline RmaOp no_op() { return RmaOp::from_system_handle(MPI_NO_OP); }
+
+/**
+ * @brief Operations created from a user function with `UserOp::create`. The function decides which
+ *  datatypes it accepts.
+ */
+struct user_op_traits {
+    template <typename T>
+    static constexpr bool is_applicable = true;
+
+    static constexpr bool is_user_defined = true;
+};
+
+using UserOp = Op<user_op_traits>;
 } // namespace mpi
 
 #endif // MPI_OP_HPP
\ No newline at end of file
@@ -0,0 +1,303 @@
+/**
+ * @file partitioned.hpp
+ *
+ * @brief Defines types for partitioned point-to-point communication.
+ * @date 2026-10-16
+ *
+ * @details
+ * With an MPI-4 library these wrap MPI_Psend_init/MPI_Precv_init. Older libraries fall back to one
+ * MPI_Isend/MPI_Irecv per partition, using the tags `[tag, tag + partitions)`.
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+#ifndef MPI_PARTITIONED_HPP
+#define MPI_PARTITIONED_HPP
+
+#include "mpi_stub_out.h"
+
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <nonstd/span.hpp>
+
+#include "datatype.hpp"
+#include "exception.hpp"
+#include "handle.hpp"
+#include "request.hpp"
+
+#if MPI_VERSION >= 4
+#define MPI_CPP_HAS_PARTITIONED 1
+#endif
+
+namespace mpi {
+namespace internal {
+/**
+ * @brief Owns a persistent request, which stays allocated across many start/wait cycles.
+ */
+class PersistentRequest : public internal::UniqueHandle<RequestHandleTraits> {
+  public:
+    PersistentRequest() = default;
+    PersistentRequest(PersistentRequest &&) = default;
+    PersistentRequest &operator=(PersistentRequest &&) = default;
+};
+
+/**
+ * @brief State shared by the send and receive sides of a partitioned operation.
+ */
+template <typename T>
+class Partitioned {
+  public:
+    Partitioned(Partitioned &&) = default;
+    Partitioned &operator=(Partitioned &&) = default;
+
+    ~Partitioned() {
+        if (active_) {
+            wait();
+        }
+    }
+
+    int partitions() const { return partitions_; }
+
+    /**
+     * @brief The number of elements in each partition.
+     */
+    std::size_t partition_size() const { return partition_size_; }
+
+    /**
+     * @brief Tests if the whole operation has completed.
+     */
+    bool test() {
+#ifdef MPI_CPP_HAS_PARTITIONED
+        int flag;
+        check_result(MPI_Test(request_.addressof(), &flag, MPI_STATUS_IGNORE));
+#else
+        int flag;
+        check_result(MPI_Testall(static_cast<int>(requests_.size()),
+                                 reinterpret_cast<MPI_Request *>(requests_.data()),
+                                 &flag,
+                                 MPI_STATUSES_IGNORE));
+#endif
+        if (flag != 0) {
+            active_ = false;
+        }
+        return flag != 0;
+    }
+
+    /**
+     * @brief Waits for the whole operation to complete. The operation can then be started again.
+     */
+    void wait() {
+#ifdef MPI_CPP_HAS_PARTITIONED
+        check_result(MPI_Wait(request_.addressof(), MPI_STATUS_IGNORE));
+#else
+        check_result(MPI_Waitall(static_cast<int>(requests_.size()),
+                                 reinterpret_cast<MPI_Request *>(requests_.data()),
+                                 MPI_STATUSES_IGNORE));
+#endif
+        active_ = false;
+    }
+
+  protected:
+    Partitioned(MPI_Comm comm, T *data, std::size_t count, int partitions, rank_t peer, tag_t tag)
+        : comm_(comm), data_(data), partitions_(partitions), peer_(peer), tag_(tag) {
+        if (partitions < 1) {
+            throw std::out_of_range("partitions must be positive");
+        }
+
+        if (count % partitions != 0) {
+            throw std::logic_error("buffer size must be a multiple of the number of partitions");
+        }
+
+        partition_size_ = count / partitions;
+        if (partition_size_ > std::numeric_limits<int>::max()) {
+            throw std::out_of_range("partition is too large");
+        }
+
+#ifndef MPI_CPP_HAS_PARTITIONED
+        requests_.resize(partitions);
+#endif
+    }
+
+    void check_partition(int partition) const {
+        if (partition < 0 || partition >= partitions_) {
+            throw std::out_of_range("partition index out of range");
+        }
+    }
+
+    T *partition_data(int partition) const { return data_ + partition * partition_size_; }
+
+    MPI_Comm comm_;
+    T *data_;
+    std::size_t partition_size_;
+    int partitions_;
+    rank_t peer_;
+    tag_t tag_;
+    bool active_ = false;
+
+#ifdef MPI_CPP_HAS_PARTITIONED
+    PersistentRequest request_;
+#else
+    std::vector<UniqueRequest> requests_;
+#endif
+};
+} // namespace internal
+
+/**
+ * @brief The sending side of a partitioned operation.
+ *
+ * @details
+ * After `start()`, each partition of the buffer is handed to MPI with `ready()` as soon as it has
+ * been filled - typically by the thread that produced it - instead of after the whole buffer.
+ * `ready()` may be called concurrently from multiple threads for different partitions. The
+ * fallback for pre-MPI-4 libraries requires MPI_THREAD_MULTIPLE for concurrent calls.
+ *
+ * Created by `Comm::partitioned_send`.
+ */
+template <typename T>
+class PartitionedSend : public internal::Partitioned<T const> {
+    using Base = internal::Partitioned<T const>;
+
+  public:
+    PartitionedSend(MPI_Comm comm,
+                    nonstd::span<T const> buffer,
+                    int partitions,
+                    rank_t dest,
+                    tag_t tag)
+        : Base(comm, buffer.data(), buffer.size(), partitions, dest, tag) {
+#ifdef MPI_CPP_HAS_PARTITIONED
+        check_result(MPI_Psend_init(this->data_,
+                                    partitions,
+                                    static_cast<MPI_Count>(this->partition_size_),
+                                    DatatypeTraits<T>::mpi_datatype(),
+                                    dest,
+                                    tag,
+                                    comm,
+                                    MPI_INFO_NULL,
+                                    this->request_.addressof()));
+#endif
+    }
+
+    /**
+     * @brief Starts a new round of the operation. Every partition must then be marked ready.
+     */
+    void start() {
+#ifdef MPI_CPP_HAS_PARTITIONED
+        check_result(MPI_Start(this->request_.addressof()));
+#endif
+        this->active_ = true;
+    }
+
+    /**
+     * @brief Marks a partition of the buffer as filled and ready to send.
+     */
+    void ready(int partition) {
+        this->check_partition(partition);
+#ifdef MPI_CPP_HAS_PARTITIONED
+        check_result(MPI_Pready(partition, this->request_.get_raw()));
+#else
+        check_result(MPI_Isend(this->partition_data(partition),
+                               static_cast<int>(this->partition_size_),
+                               DatatypeTraits<T>::mpi_datatype(),
+                               this->peer_,
+                               this->tag_ + partition,
+                               this->comm_,
+                               this->requests_[partition].addressof()));
+#endif
+    }
+
+    /**
+     * @brief Marks the partitions `[first, last]` as ready to send.
+     */
+    void ready_range(int first, int last) {
+        this->check_partition(first);
+        this->check_partition(last);
+#ifdef MPI_CPP_HAS_PARTITIONED
+        check_result(MPI_Pready_range(first, last, this->request_.get_raw()));
+#else
+        for (int partition = first; partition <= last; partition++) {
+            ready(partition);
+        }
+#endif
+    }
+};
+
+/**
+ * @brief The receiving side of a partitioned operation.
+ *
+ * @details
+ * After `start()`, `arrived()` reports whether an individual partition can be consumed, so
+ * processing can begin before the whole buffer has been received.
+ *
+ * Created by `Comm::partitioned_recv`.
+ */
+template <typename T>
+class PartitionedRecv : public internal::Partitioned<T> {
+    using Base = internal::Partitioned<T>;
+
+  public:
+    PartitionedRecv(MPI_Comm comm, nonstd::span<T> buffer, int partitions, rank_t source, tag_t tag)
+        : Base(comm, buffer.data(), buffer.size(), partitions, source, tag) {
+#ifdef MPI_CPP_HAS_PARTITIONED
+        check_result(MPI_Precv_init(this->data_,
+                                    partitions,
+                                    static_cast<MPI_Count>(this->partition_size_),
+                                    DatatypeTraits<T>::mpi_datatype(),
+                                    source,
+                                    tag,
+                                    comm,
+                                    MPI_INFO_NULL,
+                                    this->request_.addressof()));
+#endif
+    }
+
+    /**
+     * @brief Starts receiving a new round of the operation.
+     */
+    void start() {
+#ifdef MPI_CPP_HAS_PARTITIONED
+        check_result(MPI_Start(this->request_.addressof()));
+#else
+        for (int partition = 0; partition < this->partitions_; partition++) {
+            check_result(MPI_Irecv(this->partition_data(partition),
+                                   static_cast<int>(this->partition_size_),
+                                   DatatypeTraits<T>::mpi_datatype(),
+                                   this->peer_,
+                                   this->tag_ + partition,
+                                   this->comm_,
+                                   this->requests_[partition].addressof()));
+        }
+#endif
+        this->active_ = true;
+    }
+
+    /**
+     * @brief Tests if a partition has been received.
+     */
+    bool arrived(int partition) {
+        this->check_partition(partition);
+
+        int flag;
+#ifdef MPI_CPP_HAS_PARTITIONED
+        check_result(MPI_Parrived(this->request_.get_raw(), partition, &flag));
+#else
+        check_result(
+            MPI_Test(this->requests_[partition].addressof(), &flag, MPI_STATUS_IGNORE));
+#endif
+        return flag != 0;
+    }
+
+    /**
+     * @brief The elements of a partition. Only valid once `arrived(partition)` returned true.
+     */
+    nonstd::span<T> partition(int partition) const {
+        this->check_partition(partition);
+        return nonstd::span<T>(this->partition_data(partition), this->partition_size_);
+    }
+};
+} // namespace mpi
+
+#endif // MPI_PARTITIONED_HPP
@@ -0,0 +1,270 @@
+/**
+ * @file progress.hpp
+ *
+ * @brief Defines a background thread that drives outstanding requests to completion.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+#ifndef MPI_PROGRESS_HPP
+#define MPI_PROGRESS_HPP
+
+#include "mpi_stub_out.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "exception.hpp"
+#include "request.hpp"
+#include "request_set.hpp"
+#include "status.hpp"
+#include "thread.hpp"
+
+namespace mpi {
+/**
+ * @brief Polls a queue of in-flight requests on a dedicated thread.
+ *
+ * @details
+ * Many MPI implementations only make progress on non-blocking operations while inside an MPI call.
+ * Handing the requests returned by `Comm::immediate_*` routines to a ProgressEngine keeps them
+ * moving while the submitting thread computes, and completes their callbacks or futures as soon as
+ * they finish.
+ *
+ * Requires MPI to have been initialized with MPI_THREAD_MULTIPLE. Callbacks run on the progress
+ * thread, and may submit further requests.
+ *
+ * If testing the requests or a callback throws, the engine stops: every outstanding request,
+ * including any submitted later, is cancelled and released, futures are failed with the
+ * exception, and `wait_idle` rethrows it. Callbacks of abandoned requests are not invoked.
+ *
+ * Destroying the engine blocks until every submitted request has completed, or been abandoned.
+ */
+class ProgressEngine {
+  public:
+    using callback_t = RequestSet::callback_t;
+
+    /**
+     * @brief Starts the progress thread.
+     *
+     * @param poll_interval How long the progress thread sleeps between polls when none of the
+     *  in-flight requests completed. Zero yields the thread instead of sleeping.
+     *
+     * @throws std::logic_error if MPI was not initialized with MPI_THREAD_MULTIPLE
+     */
+    explicit ProgressEngine(
+        std::chrono::microseconds poll_interval = std::chrono::microseconds::zero())
+        : poll_interval_(poll_interval) {
+        if (query_thread() != ThreadLevel::Multiple) {
+            throw std::logic_error("mpi::ProgressEngine requires MPI_THREAD_MULTIPLE");
+        }
+
+        thread_ = std::thread([this] { run(); });
+    }
+
+    ProgressEngine(ProgressEngine const &) = delete;
+    ProgressEngine &operator=(ProgressEngine const &) = delete;
+
+    ~ProgressEngine() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wakeup_.notify_one();
+        thread_.join();
+    }
+
+    /**
+     * @brief Hands a request to the progress thread.
+     *
+     * @param request An active request. The engine takes ownership.
+     * @param callback Invoked on the progress thread once the request completes.
+     */
+    void submit(UniqueRequest &&request, callback_t callback) {
+        submit(std::move(request), std::move(callback), nullptr);
+    }
+
+    /**
+     * @brief Hands a request to the progress thread.
+     *
+     * @param request An active request. The engine takes ownership.
+     * @return A future that becomes ready with the completion status of the request.
+     */
+    std::future<Status> submit(UniqueRequest &&request) {
+        auto promise = std::make_shared<std::promise<Status>>();
+        auto future = promise->get_future();
+        submit(std::move(request),
+               [promise](Status const &status) { promise->set_value(status); },
+               [promise](std::exception_ptr error) { promise->set_exception(error); });
+        return future;
+    }
+
+    /**
+     * @brief The number of submitted requests that have not yet completed.
+     */
+    std::size_t outstanding() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return outstanding_;
+    }
+
+    /**
+     * @brief Blocks until every submitted request has completed.
+     *
+     * @throws The first exception raised on the progress thread, if any.
+     */
+    void wait_idle() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [this] { return outstanding_ == 0 || error_; });
+        rethrow();
+    }
+
+  private:
+    using failure_t = std::function<void(std::exception_ptr)>;
+
+    struct Pending {
+        UniqueRequest request;
+        callback_t callback;
+        failure_t failure;
+    };
+
+    void submit(UniqueRequest &&request, callback_t callback, failure_t failure) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_.push_back(
+                Pending{std::move(request), std::move(callback), std::move(failure)});
+            outstanding_++;
+        }
+        wakeup_.notify_one();
+    }
+
+    void run() {
+        RequestSet in_flight;
+        std::vector<Pending> incoming;
+
+        // The failure handlers of the requests in flight, by submission. A completion removes its
+        // handler before invoking the callback, so whatever is left when an error occurs is failed.
+        std::map<std::size_t, failure_t> failures;
+        std::size_t next_id = 0;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            std::swap(incoming, pending_);
+            auto const error = error_;
+            lock.unlock();
+
+            for (auto &p : incoming) {
+                if (error) {
+                    abandon(p, error);
+                    continue;
+                }
+
+                auto const id = next_id++;
+                if (p.failure) {
+                    failures.emplace(id, std::move(p.failure));
+                }
+                in_flight.add(std::move(p.request),
+                              [&failures, id, callback = std::move(p.callback)](
+                                  Status const &status) {
+                                  failures.erase(id);
+                                  callback(status);
+                              });
+            }
+            incoming.clear();
+
+            std::size_t num_completed = 0;
+            try {
+                num_completed = in_flight.test_some();
+            } catch (...) {
+                auto const caught = std::current_exception();
+                try {
+                    in_flight.cancel_all();
+                } catch (...) {
+                    // The first error is the one reported.
+                }
+                for (auto &f : failures) {
+                    f.second(caught);
+                }
+                failures.clear();
+
+                lock.lock();
+                if (!error_) {
+                    error_ = caught;
+                }
+                idle_.notify_all();
+                lock.unlock();
+            }
+
+            if (num_completed == 0 && !in_flight.empty()) {
+                if (poll_interval_ == std::chrono::microseconds::zero()) {
+                    std::this_thread::yield();
+                } else {
+                    std::this_thread::sleep_for(poll_interval_);
+                }
+            }
+
+            lock.lock();
+            outstanding_ = in_flight.size() + pending_.size();
+            if (outstanding_ == 0) {
+                idle_.notify_all();
+            }
+
+            if (in_flight.empty() && pending_.empty()) {
+                if (stopping_) {
+                    break;
+                }
+
+                wakeup_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+            }
+        }
+    }
+
+    /**
+     * @brief Cancels a request submitted after the engine stopped, and fails its future.
+     */
+    static void abandon(Pending &p, std::exception_ptr error) {
+        try {
+            if (p.request) {
+                check_result(MPI_Cancel(p.request.addressof()));
+                p.request.free();
+            }
+        } catch (...) {
+            // The first error is the one reported.
+        }
+        if (p.failure) {
+            p.failure(error);
+        }
+    }
+
+    void rethrow() {
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+    }
+
+    std::chrono::microseconds poll_interval_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::condition_variable idle_;
+
+    std::vector<Pending> pending_;
+    std::size_t outstanding_ = 0;
+    bool stopping_ = false;
+    std::exception_ptr error_;
+
+    std::thread thread_;
+};
+} // namespace mpi
+
+#endif // MPI_PROGRESS_HPP
@@ -0,0 +1,236 @@
+/**
+ * @file request_set.hpp
+ *
+ * @brief Defines a container of outstanding requests that dispatches a callback as each completes.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+#ifndef MPI_REQUEST_SET_HPP
+#define MPI_REQUEST_SET_HPP
+
+#include "mpi_stub_out.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "exception.hpp"
+#include "request.hpp"
+#include "status.hpp"
+
+namespace mpi {
+/**
+ * @brief Owns a set of outstanding requests, each with a callback that is invoked once the request
+ *  completes.
+ *
+ * @details
+ * Completed requests are removed from the set by moving the last request into their slot, so the
+ * set stays dense and the bookkeeping for each progress call is proportional to the number of
+ * completed requests. Callbacks are invoked after the set has been compacted, so they are free to
+ * add new requests to the set (e.g. to post the next stage of a pipeline). If a callback throws,
+ * the callbacks of the other requests that completed with it still run, and the first exception is
+ * rethrown afterwards.
+ *
+ * As with UniqueRequest, a RequestSet must be empty when it is destroyed.
+ */
+class RequestSet {
+  public:
+    using callback_t = std::function<void(Status const &)>;
+
+    RequestSet() = default;
+
+    RequestSet(RequestSet &&) = default;
+    RequestSet &operator=(RequestSet &&) = default;
+
+    /**
+     * @brief Adds a request to the set.
+     *
+     * @param request An active request. The set takes ownership.
+     * @param callback Invoked with the completion status once the request completes.
+     */
+    void add(UniqueRequest &&request, callback_t callback) {
+        if (requests_.size() >= static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+            throw std::out_of_range("too many requests in RequestSet");
+        }
+
+        requests_.push_back(std::move(request));
+        callbacks_.push_back(std::move(callback));
+    }
+
+    /**
+     * @brief Adds a request to the set that has no completion callback.
+     */
+    void add(UniqueRequest &&request) {
+        add(std::move(request), [](Status const &) {});
+    }
+
+    std::size_t size() const { return requests_.size(); }
+    bool empty() const { return requests_.empty(); }
+
+    /**
+     * @brief Completes every request that has already finished, invoking their callbacks, without
+     *  blocking.
+     *
+     * @return The number of completed requests.
+     *
+     * @throws Exception
+     */
+    std::size_t test_some() {
+        if (empty()) {
+            return 0;
+        }
+
+        prepare();
+
+        int num_completed;
+        check_result(MPI_Testsome(static_cast<int>(requests_.size()),
+                                  reinterpret_cast<MPI_Request *>(requests_.data()),
+                                  &num_completed,
+                                  indices_.data(),
+                                  reinterpret_cast<MPI_Status *>(statuses_.data())));
+
+        return dispatch(num_completed);
+    }
+
+    /**
+     * @brief Blocks until at least one request completes, then completes every request that has
+     *  finished, invoking their callbacks.
+     *
+     * @return The number of completed requests.
+     *
+     * @throws Exception
+     */
+    std::size_t wait_some() {
+        if (empty()) {
+            return 0;
+        }
+
+        prepare();
+
+        int num_completed;
+        check_result(MPI_Waitsome(static_cast<int>(requests_.size()),
+                                  reinterpret_cast<MPI_Request *>(requests_.data()),
+                                  &num_completed,
+                                  indices_.data(),
+                                  reinterpret_cast<MPI_Status *>(statuses_.data())));
+
+        return dispatch(num_completed);
+    }
+
+    /**
+     * @brief Drives the set until it is empty, including any requests added by callbacks.
+     *
+     * @throws Exception
+     */
+    void wait_all() {
+        while (!empty()) {
+            wait_some();
+        }
+    }
+
+    /**
+     * @brief Cancels and releases every request without waiting for them, and without invoking
+     *  their callbacks. Use it to abandon the set after an error.
+     *
+     * @details
+     * An operation that could not be cancelled may still complete afterwards, so its buffer must
+     * outlive it.
+     *
+     * @throws Exception
+     */
+    void cancel_all() {
+        for (auto &request : requests_) {
+            if (request) {
+                check_result(MPI_Cancel(request.addressof()));
+                request.free();
+            }
+        }
+        requests_.clear();
+        callbacks_.clear();
+    }
+
+  private:
+    void prepare() {
+        indices_.resize(requests_.size());
+        statuses_.resize(requests_.size());
+    }
+
+    std::size_t dispatch(int num_completed) {
+        if (num_completed == MPI_UNDEFINED) {
+            throw std::logic_error("RequestSet contains requests that are no longer active");
+        }
+
+        // Take the scratch storage so that callbacks which re-enter the set don't clobber it.
+        auto completed = std::move(completed_);
+        completed.clear();
+
+        for (int i = 0; i < num_completed; i++) {
+            completed.emplace_back(indices_[i], statuses_[i]);
+        }
+
+        // Compact from the back, so that the request we move into each completed slot is always
+        // one that is still active.
+        std::sort(completed.begin(),
+                  completed.end(),
+                  [](Completion const &a, Completion const &b) { return a.index > b.index; });
+
+        for (auto &c : completed) {
+            auto const last = requests_.size() - 1;
+            c.callback = std::move(callbacks_[c.index]);
+
+            if (static_cast<std::size_t>(c.index) != last) {
+                requests_[c.index] = std::move(requests_[last]);
+                callbacks_[c.index] = std::move(callbacks_[last]);
+            }
+
+            requests_.pop_back();
+            callbacks_.pop_back();
+        }
+
+        // The requests have already left the set, so every callback must run even if one throws.
+        std::exception_ptr error;
+        for (auto it = completed.rbegin(); it != completed.rend(); ++it) {
+            try {
+                it->callback(it->status);
+            } catch (...) {
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+
+        completed.clear();
+        completed_ = std::move(completed);
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+
+        return static_cast<std::size_t>(num_completed);
+    }
+
+    struct Completion {
+        Completion(int index, Status status) : index(index), status(status) {}
+
+        int index;
+        Status status;
+        callback_t callback;
+    };
+
+    std::vector<UniqueRequest> requests_;
+    std::vector<callback_t> callbacks_;
+
+    std::vector<int> indices_;
+    std::vector<Status> statuses_;
+    std::vector<Completion> completed_;
+};
+} // namespace mpi
+
+#endif // MPI_REQUEST_SET_HPP
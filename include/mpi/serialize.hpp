@@ -0,0 +1,426 @@
+/**
+ * @file serialize.hpp
+ *
+ * @brief Defines a trait-based framework for serializing non-trivial types into byte buffers.
+ * @date 2026-10-16
+ *
+ * @details
+ * Each serializable type has a specialization of `mpi::Serializer<T>` with three functions:
+ * `size` computes the space needed up front, so a value is serialized into a single buffer with no
+ * reallocation; `serialize` writes the value; and `deserialize` reads it back.
+ *
+ * Out of the box, trivially copyable types, `std::string`, `std::vector`, `std::map` and
+ * `std::pair` are supported, nested arbitrarily. Contiguous runs of trivially copyable elements
+ * are aligned in the buffer, so they can also be deserialized as `nonstd::span<T const>` views
+ * that point into the buffer instead of copying out of it.
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+#ifndef MPI_SERIALIZE_HPP
+#define MPI_SERIALIZE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <nonstd/span.hpp>
+
+namespace mpi {
+/**
+ * @brief Computes the serialized size of values, including alignment padding.
+ */
+class SerialSizer {
+  public:
+    void add(std::size_t bytes) { size_ += bytes; }
+    void align(std::size_t alignment) { size_ = (size_ + alignment - 1) / alignment * alignment; }
+
+    std::size_t size() const { return size_; }
+
+  private:
+    std::size_t size_ = 0;
+};
+
+/**
+ * @brief Writes serialized values into a buffer sized by SerialSizer.
+ */
+class SerialWriter {
+  public:
+    explicit SerialWriter(nonstd::span<char> buffer) : buffer_(buffer) {}
+
+    void write(void const *data, std::size_t bytes) {
+        check(bytes);
+        std::memcpy(buffer_.data() + offset_, data, bytes);
+        offset_ += bytes;
+    }
+
+    void align(std::size_t alignment) {
+        auto const aligned = (offset_ + alignment - 1) / alignment * alignment;
+        check(aligned - offset_);
+        std::memset(buffer_.data() + offset_, 0, aligned - offset_);
+        offset_ = aligned;
+    }
+
+    std::size_t offset() const { return offset_; }
+
+  private:
+    void check(std::size_t bytes) const {
+        if (bytes > buffer_.size() - offset_) {
+            throw std::out_of_range("serialization buffer is too small");
+        }
+    }
+
+    nonstd::span<char> buffer_;
+    std::size_t offset_ = 0;
+};
+
+/**
+ * @brief Reads serialized values out of a buffer.
+ *
+ * @details
+ * Alignment is relative to the start of the buffer, so views are only possible if the buffer
+ * itself is suitably aligned, as memory from `new` or `std::vector<char>` is.
+ */
+class SerialReader {
+  public:
+    explicit SerialReader(nonstd::span<char const> buffer) : buffer_(buffer) {}
+
+    void read(void *data, std::size_t bytes) { std::memcpy(data, take(bytes), bytes); }
+
+    /**
+     * @brief Consumes `bytes` bytes, returning a pointer to them within the buffer.
+     */
+    char const *take(std::size_t bytes) {
+        if (bytes > buffer_.size() - offset_) {
+            throw std::out_of_range("serialized data is truncated");
+        }
+
+        auto const *const data = buffer_.data() + offset_;
+        offset_ += bytes;
+        return data;
+    }
+
+    void align(std::size_t alignment) {
+        auto const aligned = (offset_ + alignment - 1) / alignment * alignment;
+        take(aligned - offset_);
+    }
+
+    std::size_t offset() const { return offset_; }
+    bool done() const { return offset_ == buffer_.size(); }
+
+  private:
+    nonstd::span<char const> buffer_;
+    std::size_t offset_ = 0;
+};
+
+template <typename T, typename Enable = void>
+struct Serializer;
+
+namespace internal {
+template <typename T>
+struct IsPair : std::false_type {};
+
+template <typename A, typename B>
+struct IsPair<std::pair<A, B>> : std::true_type {};
+
+template <typename T>
+struct IsSpan : std::false_type {};
+
+template <typename T>
+struct IsSpan<nonstd::span<T>> : std::true_type {};
+
+/**
+ * @brief Types that are serialized by copying their bytes. Spans are trivially copyable, but
+ *  serialize the elements they refer to.
+ */
+template <typename T>
+using is_bytewise = std::integral_constant<bool,
+                                           std::is_trivially_copyable<T>::value &&
+                                               !IsPair<T>::value && !IsSpan<T>::value>;
+
+using length_t = std::uint64_t;
+
+template <typename T>
+void size_elements(SerialSizer &sizer, T const *, std::size_t count, std::true_type) {
+    sizer.add(sizeof(length_t));
+    sizer.align(alignof(T));
+    sizer.add(count * sizeof(T));
+}
+
+template <typename T>
+void size_elements(SerialSizer &sizer, T const *data, std::size_t count, std::false_type) {
+    sizer.add(sizeof(length_t));
+    for (std::size_t i = 0; i < count; i++) {
+        Serializer<T>::size(sizer, data[i]);
+    }
+}
+
+template <typename T>
+void serialize_elements(SerialWriter &writer, T const *data, std::size_t count, std::true_type) {
+    length_t const length = count;
+    writer.write(&length, sizeof(length));
+    writer.align(alignof(T));
+    writer.write(data, count * sizeof(T));
+}
+
+template <typename T>
+void serialize_elements(SerialWriter &writer, T const *data, std::size_t count, std::false_type) {
+    length_t const length = count;
+    writer.write(&length, sizeof(length));
+    for (std::size_t i = 0; i < count; i++) {
+        Serializer<T>::serialize(writer, data[i]);
+    }
+}
+
+inline std::size_t read_length(SerialReader &reader) {
+    length_t length;
+    reader.read(&length, sizeof(length));
+    return static_cast<std::size_t>(length);
+}
+
+/**
+ * @brief Reads a run of bytewise elements in place, returning a pointer into the buffer.
+ */
+template <typename T>
+T const *take_elements(SerialReader &reader, std::size_t count) {
+    reader.align(alignof(T));
+    if (count > std::size_t(-1) / sizeof(T)) {
+        throw std::out_of_range("serialized data is truncated");
+    }
+    return reinterpret_cast<T const *>(reader.take(count * sizeof(T)));
+}
+} // namespace internal
+
+/**
+ * @brief Serializes trivially copyable types by copying their bytes.
+ */
+template <typename T>
+struct Serializer<T, std::enable_if_t<internal::is_bytewise<T>::value>> {
+    static void size(SerialSizer &sizer, T const &) { sizer.add(sizeof(T)); }
+    static void serialize(SerialWriter &writer, T const &value) {
+        writer.write(&value, sizeof(T));
+    }
+    static void deserialize(SerialReader &reader, T &value) { reader.read(&value, sizeof(T)); }
+};
+
+template <typename T, typename A>
+struct Serializer<std::vector<T, A>> {
+    static void size(SerialSizer &sizer, std::vector<T, A> const &value) {
+        internal::size_elements(sizer, value.data(), value.size(), internal::is_bytewise<T>{});
+    }
+
+    static void serialize(SerialWriter &writer, std::vector<T, A> const &value) {
+        internal::serialize_elements(
+            writer, value.data(), value.size(), internal::is_bytewise<T>{});
+    }
+
+    static void deserialize(SerialReader &reader, std::vector<T, A> &value) {
+        deserialize(reader, value, internal::is_bytewise<T>{});
+    }
+
+  private:
+    static void deserialize(SerialReader &reader, std::vector<T, A> &value, std::true_type) {
+        auto const count = internal::read_length(reader);
+        auto const *const data = internal::take_elements<T>(reader, count);
+
+        // The buffer may not be aligned, so copy the bytes rather than the elements.
+        value.resize(count);
+        std::memcpy(value.data(), data, count * sizeof(T));
+    }
+
+    static void deserialize(SerialReader &reader, std::vector<T, A> &value, std::false_type) {
+        auto const count = internal::read_length(reader);
+        value.clear();
+        value.resize(count);
+        for (auto &element : value) {
+            Serializer<T>::deserialize(reader, element);
+        }
+    }
+};
+
+/**
+ * @brief Serializes a `std::vector<bool>`, which packs its elements into bits and so has no
+ *  `data()`, as a length followed by one byte per element.
+ */
+template <typename A>
+struct Serializer<std::vector<bool, A>> {
+    static void size(SerialSizer &sizer, std::vector<bool, A> const &value) {
+        sizer.add(sizeof(internal::length_t));
+        sizer.add(value.size());
+    }
+
+    static void serialize(SerialWriter &writer, std::vector<bool, A> const &value) {
+        internal::length_t const length = value.size();
+        writer.write(&length, sizeof(length));
+        for (bool const element : value) {
+            std::uint8_t const byte = element;
+            writer.write(&byte, sizeof(byte));
+        }
+    }
+
+    static void deserialize(SerialReader &reader, std::vector<bool, A> &value) {
+        auto const count = internal::read_length(reader);
+        auto const *const bytes = internal::take_elements<std::uint8_t>(reader, count);
+
+        value.clear();
+        value.reserve(count);
+        for (std::size_t i = 0; i < count; i++) {
+            value.push_back(bytes[i] != 0);
+        }
+    }
+};
+
+/**
+ * @brief Serializes a span in the same format as a vector, and deserializes it as a view into
+ *  the buffer without copying.
+ */
+template <typename T>
+struct Serializer<nonstd::span<T const>, std::enable_if_t<internal::is_bytewise<T>::value>> {
+    static void size(SerialSizer &sizer, nonstd::span<T const> value) {
+        internal::size_elements(sizer, value.data(), value.size(), std::true_type{});
+    }
+
+    static void serialize(SerialWriter &writer, nonstd::span<T const> value) {
+        internal::serialize_elements(writer, value.data(), value.size(), std::true_type{});
+    }
+
+    static void deserialize(SerialReader &reader, nonstd::span<T const> &value) {
+        auto const count = internal::read_length(reader);
+        auto const *const data = internal::take_elements<T>(reader, count);
+        if (reinterpret_cast<std::uintptr_t>(data) % alignof(T) != 0) {
+            throw std::logic_error("serialization buffer is not aligned for a view");
+        }
+        value = nonstd::span<T const>(data, count);
+    }
+};
+
+/**
+ * @brief Serializes a string in the same format as a `std::vector<char>`, so it can be viewed as a
+ *  `nonstd::span<char const>`.
+ */
+template <>
+struct Serializer<std::string> {
+    static void size(SerialSizer &sizer, std::string const &value) {
+        internal::size_elements(sizer, value.data(), value.size(), std::true_type{});
+    }
+
+    static void serialize(SerialWriter &writer, std::string const &value) {
+        internal::serialize_elements(writer, value.data(), value.size(), std::true_type{});
+    }
+
+    static void deserialize(SerialReader &reader, std::string &value) {
+        auto const count = internal::read_length(reader);
+        value.assign(internal::take_elements<char>(reader, count), count);
+    }
+};
+
+template <typename A, typename B>
+struct Serializer<std::pair<A, B>> {
+    static void size(SerialSizer &sizer, std::pair<A, B> const &value) {
+        Serializer<std::remove_const_t<A>>::size(sizer, value.first);
+        Serializer<B>::size(sizer, value.second);
+    }
+
+    static void serialize(SerialWriter &writer, std::pair<A, B> const &value) {
+        Serializer<std::remove_const_t<A>>::serialize(writer, value.first);
+        Serializer<B>::serialize(writer, value.second);
+    }
+
+    static void deserialize(SerialReader &reader, std::pair<A, B> &value) {
+        Serializer<A>::deserialize(reader, value.first);
+        Serializer<B>::deserialize(reader, value.second);
+    }
+};
+
+template <typename K, typename V, typename C, typename A>
+struct Serializer<std::map<K, V, C, A>> {
+    static void size(SerialSizer &sizer, std::map<K, V, C, A> const &value) {
+        sizer.add(sizeof(internal::length_t));
+        for (auto const &entry : value) {
+            Serializer<K>::size(sizer, entry.first);
+            Serializer<V>::size(sizer, entry.second);
+        }
+    }
+
+    static void serialize(SerialWriter &writer, std::map<K, V, C, A> const &value) {
+        internal::length_t const length = value.size();
+        writer.write(&length, sizeof(length));
+        for (auto const &entry : value) {
+            Serializer<K>::serialize(writer, entry.first);
+            Serializer<V>::serialize(writer, entry.second);
+        }
+    }
+
+    static void deserialize(SerialReader &reader, std::map<K, V, C, A> &value) {
+        auto const count = internal::read_length(reader);
+        value.clear();
+        for (std::size_t i = 0; i < count; i++) {
+            std::pair<K, V> entry;
+            Serializer<K>::deserialize(reader, entry.first);
+            Serializer<V>::deserialize(reader, entry.second);
+            value.emplace_hint(value.end(), std::move(entry));
+        }
+    }
+};
+
+/**
+ * @brief Computes the number of bytes needed to serialize `value`.
+ */
+template <typename T>
+std::size_t serialized_size(T const &value) {
+    SerialSizer sizer;
+    Serializer<T>::size(sizer, value);
+    return sizer.size();
+}
+
+/**
+ * @brief Serializes `value` into `buffer`, which must be at least `serialized_size(value)` bytes
+ *  and suitably aligned.
+ *
+ * @return The number of bytes written.
+ */
+template <typename T>
+std::size_t serialize_into(T const &value, nonstd::span<char> buffer) {
+    SerialWriter writer(buffer);
+    Serializer<T>::serialize(writer, value);
+    return writer.offset();
+}
+
+/**
+ * @brief Serializes `value` into a new buffer of exactly the right size.
+ */
+template <typename T>
+std::vector<char> serialize(T const &value) {
+    std::vector<char> buffer(serialized_size(value));
+    serialize_into(value, nonstd::span<char>(buffer));
+    return buffer;
+}
+
+/**
+ * @brief Deserializes a `T` from `buffer`.
+ *
+ * @details
+ * `T` may contain `nonstd::span<U const>` in place of vectors of trivially copyable `U`, in which
+ * case they point into `buffer` and are only valid for as long as it is.
+ *
+ * @throws std::out_of_range if the buffer is truncated or has trailing bytes
+ */
+template <typename T>
+T deserialize(nonstd::span<char const> buffer) {
+    SerialReader reader(buffer);
+    T value;
+    Serializer<T>::deserialize(reader, value);
+    if (!reader.done()) {
+        throw std::out_of_range("serialized data has trailing bytes");
+    }
+    return value;
+}
+} // namespace mpi
+
+#endif // MPI_SERIALIZE_HPP
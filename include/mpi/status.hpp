@@ -12,6 +12,11 @@
 
 #include "mpi_stub_out.h"
 
+#include <stdexcept>
+
+#include "datatype.hpp"
+#include "exception.hpp"
+
 namespace mpi {
 
 class Status {
@@ -31,6 +36,21 @@ class Status {
     int error() const { return status.MPI_ERROR; }
 
     bool success() const { return error() == MPI_SUCCESS; }
+
+    /**
+     * @brief Gets the number of elements of type `T` in the message described by this status.
+     *
+     * @throws std::logic_error if the message is not a whole number of `T`s
+     */
+    template <typename T, typename = std::enable_if_t<is_datatype_v<T>>>
+    int count() const {
+        int count;
+        check_result(MPI_Get_count(&status, DatatypeTraits<T>::mpi_datatype(), &count));
+        if (count == MPI_UNDEFINED) {
+            throw std::logic_error("message size is not a multiple of the datatype size");
+        }
+        return count;
+    }
 };
 
 static_assert(sizeof(Status) == sizeof(MPI_Status),
@@ -0,0 +1,237 @@
+/**
+ * @file streaming_writer.hpp
+ *
+ * @brief Defines a writer that overlaps collective file output with computation.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+#ifndef MPI_STREAMING_WRITER_HPP
+#define MPI_STREAMING_WRITER_HPP
+
+#include "mpi_stub_out.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <nonstd/span.hpp>
+
+#include "buffer_pool.hpp"
+#include "comm.hpp"
+#include "deref.hpp"
+#include "file.hpp"
+#include "info.hpp"
+#include "op.hpp"
+#include "request.hpp"
+
+namespace mpi {
+/**
+ * @brief Appends a sequence of steps, such as the timesteps of a simulation, to a shared file
+ *  without waiting for each one to reach the file.
+ *
+ * @details
+ * `write_step` copies this process' slab into a staging buffer and starts a nonblocking collective
+ * write of it, so the caller can go on computing while the data is written. Each step is stored
+ * after the previous one, with the slabs of each step in rank order.
+ *
+ * At most `max_pending` steps are in flight at once, which bounds the memory used for staging.
+ * Once that many are pending, `write_step` first waits for the oldest one, so a solver that
+ * outpaces the file system is slowed down rather than running out of memory. Staging buffers come
+ * from the communicator's `buffer_pool()`, so they are reused from step to step.
+ *
+ * The only other synchronization per step is a single all_gather of the slab sizes, from which
+ * each process computes its offset and the size of the step.
+ *
+ * Without MPI 3.1's MPI_File_iwrite_at_all, each step is written straight from the slab with a
+ * blocking collective write.
+ *
+ * Call `close` to learn of errors in the pending writes; the destructor waits for them too, but
+ * ignores errors, since it cannot throw.
+ *
+ * Construction, `write_step`, `flush`, `close` and destruction are collective over the
+ * communicator.
+ */
+class StreamingWriter {
+  public:
+    /**
+     * @param comm The processes writing the file
+     * @param path The file to create, or truncate
+     * @param max_pending The number of steps that may be in flight at once; 2 double-buffers
+     * @param info Hints used to open the file
+     */
+    template <typename From>
+    StreamingWriter(trait::Deref<From, Comm> const &comm,
+                    std::string const &path,
+                    std::size_t max_pending = 2,
+                    Info const &info = Info{})
+        : comm_(comm.deref()), max_pending_(max_pending) {
+        if (max_pending_ == 0) {
+            throw std::out_of_range("at least one step must be allowed in flight");
+        }
+
+        file_ = UniqueFile::open(comm_, path, FileMode::Create | FileMode::WriteOnly, info);
+        file_.set_size(0);
+    }
+
+    StreamingWriter(StreamingWriter const &) = delete;
+    StreamingWriter &operator=(StreamingWriter const &) = delete;
+
+    /**
+     * @brief Waits for every pending step, then closes the file, ignoring any errors.
+     */
+    ~StreamingWriter() {
+        try {
+            close();
+        } catch (...) {
+            // Destructors must not throw; `close` reports errors to callers that want them.
+        }
+    }
+
+    /**
+     * @brief Starts writing this process' slab of the next step. `slab` may be reused as soon as
+     *  this returns.
+     */
+    template <typename T>
+    void write_step(nonstd::span<T const> slab) {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "slabs are written as bytes, so must be trivially copyable");
+
+        if (!file_) {
+            throw std::logic_error("StreamingWriter has already been closed");
+        }
+
+        std::uint64_t const bytes = slab.size() * sizeof(T);
+        auto const sizes = comm_.all_gather(bytes);
+
+        auto offset = end_;
+        for (rank_t r = 0; r < comm_.rank(); r++) {
+            offset += sizes[r];
+        }
+        for (auto const size : sizes) {
+            end_ += size;
+        }
+
+#ifdef MPI_CPP_HAS_NONBLOCKING_COLLECTIVE_IO
+        while (pending_.size() >= max_pending_) {
+            pending_.front().request.wait();
+            pending_.pop_front();
+        }
+
+        PooledBuffer<char> staging(comm_.buffer_pool(), bytes);
+        std::memcpy(staging.data(), slab.data(), bytes);
+
+        Step step;
+        step.buffer = std::move(staging);
+        step.request = file_.iwrite_at_all(static_cast<offset_t>(offset),
+                                           nonstd::span<char const>(step.buffer));
+        pending_.push_back(std::move(step));
+#else
+        file_.write_at_all(
+            static_cast<offset_t>(offset),
+            nonstd::span<char const>(reinterpret_cast<char const *>(slab.data()), bytes));
+#endif
+        steps_++;
+    }
+
+    template <typename T>
+    void write_step(std::vector<T> const &slab) {
+        write_step(nonstd::span<T const>(slab));
+    }
+
+    /**
+     * @brief Retires the steps that have finished writing, without blocking. Calling this now and
+     *  then also lets MPI make progress on the writes.
+     *
+     * @return The number of steps still in flight.
+     */
+    std::size_t progress() {
+        while (!pending_.empty() && pending_.front().request.test()) {
+            pending_.pop_front();
+        }
+        return pending_.size();
+    }
+
+    /**
+     * @brief Waits for every step to be written.
+     */
+    void flush() {
+        while (!pending_.empty()) {
+            pending_.front().request.wait();
+            pending_.pop_front();
+        }
+    }
+
+    /**
+     * @brief Waits for every step to be written, then closes the file. Further steps cannot be
+     *  written.
+     *
+     * @throws Exception if a write failed
+     */
+    void close() {
+        // Keep going after a failed write, since closing is collective and the other processes
+        // will close too; the first error is rethrown once the file is closed.
+        std::exception_ptr error;
+        while (!pending_.empty()) {
+            auto &request = pending_.front().request;
+            try {
+                request.wait();
+            } catch (...) {
+                if (!error) {
+                    error = std::current_exception();
+                }
+                try {
+                    request.free();
+                } catch (...) {
+                    request.into_raw();
+                }
+            }
+            pending_.pop_front();
+        }
+
+        try {
+            file_ = UniqueFile();
+        } catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
+            file_.into_raw();
+        }
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    std::size_t pending() const { return pending_.size(); }
+    std::size_t steps() const { return steps_; }
+
+    /**
+     * @brief The size of the file, in bytes, once every step has been written.
+     */
+    std::uint64_t size() const { return end_; }
+
+  private:
+    struct Step {
+        PooledBuffer<char> buffer;
+        UniqueRequest request;
+    };
+
+    Comm comm_;
+    UniqueFile file_;
+    std::size_t max_pending_;
+
+    std::deque<Step> pending_;
+    std::uint64_t end_ = 0;
+    std::size_t steps_ = 0;
+};
+} // namespace mpi
+
+#endif // MPI_STREAMING_WRITER_HPP
@@ -0,0 +1,168 @@
+/**
+ * @file tag_allocator.hpp
+ *
+ * @brief Defines an allocator of disjoint tag ranges, so independent components can share a
+ *  communicator.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+#ifndef MPI_TAG_ALLOCATOR_HPP
+#define MPI_TAG_ALLOCATOR_HPP
+
+#include "mpi_stub_out.h"
+
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+#include "datatype.hpp"
+
+namespace mpi {
+/**
+ * @brief A contiguous range of tags, `[first, first + count)`.
+ */
+struct TagRange {
+    tag_t first = 0;
+    tag_t count = 0;
+
+    /**
+     * @brief The `i`th tag in the range.
+     */
+    tag_t operator[](tag_t i) const { return first + i; }
+
+    tag_t last() const { return first + count - 1; }
+    bool contains(tag_t tag) const { return tag >= first && tag - first < count; }
+    bool empty() const { return count == 0; }
+};
+
+/**
+ * @brief Hands out disjoint ranges of the tags of a communicator.
+ *
+ * @details
+ * Ranges are carved downwards from the communicator's MPI_TAG_UB, which is looked up once. Tags
+ * below `reserved_tags` are never handed out, so they stay free for direct use, such as the
+ * default tag 0 of `Comm::immediate_send` and `Comm::immediate_recv`. Released ranges are reused,
+ * first fit, and merged with their neighbors.
+ *
+ * The allocator is local to each process. Peers agree on the tags of a range as long as every
+ * process allocates and releases the same ranges in the same order, as happens when each
+ * component allocates its tags during its (collective) setup.
+ *
+ * Get the allocator for a communicator with `Comm::tag_allocator()`. It is safe to use from
+ * multiple threads.
+ */
+class TagAllocator {
+  public:
+    /**
+     * @brief The number of small tags that are left for direct use.
+     */
+    static constexpr tag_t reserved_tags = 1024;
+
+    explicit TagAllocator(tag_t tag_ub)
+        : tag_ub_(tag_ub),
+          floor_(tag_ub < reserved_tags ? reserved_tags : std::int64_t(tag_ub) + 1) {}
+
+    // A duplicated communicator has a fresh tag space, so the allocator is not copied with it.
+    TagAllocator(TagAllocator const &) = delete;
+    TagAllocator &operator=(TagAllocator const &) = delete;
+
+    /**
+     * @brief The largest tag of the communicator.
+     */
+    tag_t tag_ub() const { return tag_ub_; }
+
+    /**
+     * @brief Allocates `count` consecutive tags.
+     *
+     * @throws std::out_of_range if there is no free range of `count` tags
+     */
+    TagRange allocate(tag_t count) {
+        if (count < 1) {
+            throw std::out_of_range("must allocate at least one tag");
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        for (auto it = free_.begin(); it != free_.end(); ++it) {
+            if (it->second >= count) {
+                TagRange range{it->first, count};
+                if (it->second > count) {
+                    free_.emplace(it->first + count, it->second - count);
+                }
+                free_.erase(it);
+                return range;
+            }
+        }
+
+        if (count > floor_ - reserved_tags) {
+            throw std::out_of_range("not enough free tags on the communicator");
+        }
+
+        floor_ -= count;
+        return TagRange{static_cast<tag_t>(floor_), count};
+    }
+
+    /**
+     * @brief Returns a range from `allocate` to the allocator.
+     */
+    void release(TagRange range) {
+        if (range.empty()) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto next = free_.lower_bound(range.first);
+        if (next != free_.end() && next->first - range.count == range.first) {
+            range.count += next->second;
+            next = free_.erase(next);
+        }
+
+        if (next != free_.begin()) {
+            auto const prev = std::prev(next);
+            if (prev->first + prev->second == range.first) {
+                range.first = prev->first;
+                range.count += prev->second;
+                free_.erase(prev);
+            }
+        }
+
+        if (range.first == floor_) {
+            floor_ += range.count;
+        } else {
+            free_.emplace(range.first, range.count);
+        }
+    }
+
+    /**
+     * @brief The number of tags that have not been allocated.
+     */
+    std::int64_t available() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto available = floor_ - reserved_tags;
+        for (auto const &range : free_) {
+            available += range.second;
+        }
+        return available;
+    }
+
+  private:
+    tag_t tag_ub_;
+
+    mutable std::mutex mutex_;
+
+    // Tags at or above the floor have been handed out at some point, and those below are unused.
+    // Wider than tag_t, since it starts one past MPI_TAG_UB.
+    std::int64_t floor_;
+
+    // Released ranges above the floor, as first -> count.
+    std::map<tag_t, tag_t> free_;
+};
+} // namespace mpi
+
+#endif // MPI_TAG_ALLOCATOR_HPP
@@ -0,0 +1,103 @@
+/**
+ * @file thread.hpp
+ *
+ * @brief Defines routines for querying MPI thread support and for giving each thread its own
+ *  communicator.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+#ifndef MPI_THREAD_HPP
+#define MPI_THREAD_HPP
+
+#include "mpi_stub_out.h"
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "comm.hpp"
+#include "deref.hpp"
+#include "exception.hpp"
+
+namespace mpi {
+/**
+ * @brief The levels of thread support an MPI implementation can provide, in increasing order.
+ */
+enum class ThreadLevel {
+    Single = MPI_THREAD_SINGLE,
+    Funneled = MPI_THREAD_FUNNELED,
+    Serialized = MPI_THREAD_SERIALIZED,
+    Multiple = MPI_THREAD_MULTIPLE,
+};
+
+/**
+ * @brief Gets the level of thread support provided by the MPI library.
+ *
+ * @throws Exception
+ */
+inline ThreadLevel query_thread() {
+    int provided;
+    check_result(MPI_Query_thread(&provided));
+    return static_cast<ThreadLevel>(provided);
+}
+
+/**
+ * @brief Checks if the calling thread is the thread that initialized MPI.
+ *
+ * @throws Exception
+ */
+inline bool is_thread_main() {
+    int flag;
+    check_result(MPI_Is_thread_main(&flag));
+    return flag != 0;
+}
+
+/**
+ * @brief Holds a separate duplicate of a communicator for each worker thread.
+ *
+ * @details
+ * Under MPI_THREAD_MULTIPLE, threads sending on a shared communicator contend for its matching
+ * state. Giving each thread its own communicator removes that contention, and keeps the messages of
+ * different threads from matching each other. Thread `i` on one rank should communicate with
+ * thread `i` on other ranks using `pool[i]`.
+ *
+ * Construction and destruction are collective over the communicator.
+ */
+class ThreadCommPool {
+  public:
+    /**
+     * @brief Duplicates `comm` once for each of `threads` threads.
+     */
+    template <typename From>
+    ThreadCommPool(trait::Deref<From, Comm> const &comm, std::size_t threads) {
+        comms_.reserve(threads);
+        for (std::size_t i = 0; i < threads; i++) {
+            comms_.push_back(comm.deref().dup());
+        }
+    }
+
+    std::size_t size() const { return comms_.size(); }
+
+    /**
+     * @brief The communicator for thread `thread`.
+     */
+    Comm operator[](std::size_t thread) const { return comms_[thread].deref(); }
+
+    /**
+     * @brief The communicator for thread `thread`, with bounds checking.
+     */
+    Comm at(std::size_t thread) const {
+        if (thread >= comms_.size()) {
+            throw std::out_of_range("ThreadCommPool::at: thread index out of range");
+        }
+        return (*this)[thread];
+    }
+
+  private:
+    std::vector<UniqueComm> comms_;
+};
+} // namespace mpi
+
+#endif // MPI_THREAD_HPP
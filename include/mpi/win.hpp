@@ -14,15 +14,9 @@
 #include "comm.hpp"
 #include "exception.hpp"
 #include "handle.hpp"
+#include "info.hpp"
 
 namespace mpi {
-class Info {
-    MPI_Info _info = MPI_INFO_NULL;
-
-  public:
-    MPI_Info info() const { return _info; }
-};
-
 enum class WinLockAssertFlags {
     None = 0,
     NoCheck = MPI_MODE_NOCHECK,
@@ -143,6 +137,124 @@ class WinImpl : public trait::Deref<ConcreteType, Win<T>>,
 
     void flush_all() { check_result(MPI_Win_flush_all(win())); }
 
+    /**
+     * @brief Completes all outstanding RMA operations targeting `rank` at both the origin and the
+     *  target.
+     *
+     * @param rank Target rank of the operations to complete
+     */
+    void flush(rank_t rank) { check_result(MPI_Win_flush(rank, win())); }
+
+    /**
+     * @brief Completes all outstanding RMA operations targeting `rank` at the origin only, making
+     *  origin buffers safe to reuse.
+     *
+     * @param rank Target rank of the operations to complete
+     */
+    void flush_local(rank_t rank) { check_result(MPI_Win_flush_local(rank, win())); }
+
+    /**
+     * @brief Completes all outstanding RMA operations at the origin only, for every target, making
+     *  origin buffers safe to reuse.
+     */
+    void flush_local_all() { check_result(MPI_Win_flush_local_all(win())); }
+
+    /**
+     * @brief Synchronizes the private and public copies of the local window memory.
+     */
+    void sync() { check_result(MPI_Win_sync(win())); }
+
+    /**
+     * @brief Atomically applies `op` to a single element of the target window, returning the
+     *  element's previous value.
+     *
+     * @details
+     * The operation is flushed before returning, so the result is immediately valid. Must be
+     * called within a passive-target epoch (e.g. after `lock_all()`).
+     *
+     * @param op Operation to apply, e.g. `mpi::sum()` or `mpi::no_op()` for an atomic read
+     * @param value Origin operand
+     * @param target Rank owning the element
+     * @param target_disp Index of the element in the target window
+     * @return The value of the element before `op` was applied
+     */
+    template <typename OpTraits>
+    T fetch_and_op(Op<OpTraits> const &op, T const &value, rank_t target, aint_t target_disp) {
+        static_assert(OpTraits::template is_applicable<T>,
+                      "The supplied data type is not valid for this MPI operation.");
+
+        T result;
+        check_result(MPI_Fetch_and_op(&value,
+                                      &result,
+                                      DatatypeTraits<T>::mpi_datatype(),
+                                      target,
+                                      target_disp,
+                                      op.op(),
+                                      win()));
+        flush(target);
+        return result;
+    }
+
+    /**
+     * @brief Atomically replaces a single element of the target window with `value` if it is
+     *  equal to `compare`.
+     *
+     * @details
+     * The operation is flushed before returning. Must be called within a passive-target epoch.
+     *
+     * @return The value of the element before the operation. The swap succeeded if this is equal
+     *  to `compare`.
+     */
+    T compare_and_swap(T const &value, T const &compare, rank_t target, aint_t target_disp) {
+        T result;
+        check_result(MPI_Compare_and_swap(&value,
+                                          &compare,
+                                          &result,
+                                          DatatypeTraits<T>::mpi_datatype(),
+                                          target,
+                                          target_disp,
+                                          win()));
+        flush(target);
+        return result;
+    }
+
+    /**
+     * @brief Atomically applies `op` element-wise to `send_count` elements of the target window.
+     *
+     * @details
+     * Unlike `fetch_and_op`, the operation is not flushed; it completes at the next flush or
+     * unlock. Must be called within an access epoch.
+     *
+     * @param op Operation to apply, e.g. `mpi::sum()` or `mpi::replace()`
+     * @param send Origin operands, which must not be modified until the operation completes
+     * @param send_count Number of elements to apply `op` to
+     * @param target Rank owning the elements
+     * @param target_disp Index of the first element in the target window
+     */
+    template <typename OpTraits>
+    void accumulate(Op<OpTraits> const &op,
+                    T const send[],
+                    std::size_t send_count,
+                    rank_t target,
+                    aint_t target_disp) {
+        static_assert(OpTraits::template is_applicable<T>,
+                      "The supplied data type is not valid for this MPI operation.");
+
+        if (send_count > std::numeric_limits<int>::max()) {
+            throw std::out_of_range("send array is too large");
+        }
+
+        check_result(MPI_Accumulate(send,
+                                    static_cast<int>(send_count),
+                                    DatatypeTraits<T>::mpi_datatype(),
+                                    target,
+                                    target_disp,
+                                    static_cast<int>(send_count),
+                                    DatatypeTraits<T>::mpi_datatype(),
+                                    op.op(),
+                                    win()));
+    }
+
     void get(T recv[], std::size_t recv_count, rank_t target, aint_t target_disp) {
         check_result(MPI_Get(recv,
                              recv_count,
@@ -0,0 +1,177 @@
+/**
+ * @file work_queue.hpp
+ *
+ * @brief Defines a distributed, self-scheduling work queue built on one-sided MPI operations.
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+#ifndef MPI_WORK_QUEUE_HPP
+#define MPI_WORK_QUEUE_HPP
+
+#include "mpi_stub_out.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+
+#include "comm.hpp"
+#include "counter.hpp"
+#include "deref.hpp"
+
+namespace mpi {
+/**
+ * @brief A half-open range of work items, `[first, last)`.
+ */
+struct WorkRange {
+    std::int64_t first = 0;
+    std::int64_t last = 0;
+
+    std::int64_t size() const { return last - first; }
+    bool empty() const { return first >= last; }
+};
+
+/**
+ * @brief Hands out the items `[0, count)` to the ranks of a communicator without a central server.
+ *
+ * @details
+ * The items are split into one contiguous block per rank. Each block has an atomic cursor living on
+ * its owning rank. A rank first claims chunks from its own block, and once that is exhausted steals
+ * chunks from other ranks' blocks, so every claim is a single MPI_Fetch_and_op against one rank
+ * rather than a round-trip through a master.
+ *
+ * Stealing starts at a victim chosen at random per rank and moves on to the following blocks, and a
+ * rank gives up after `max_failed_steals` probes of exhausted blocks. Every block is emptied by its
+ * owner before the owner looks elsewhere, so giving up never leaves items unclaimed; it only bounds
+ * the remote atomics spent at the end of the run to `max_failed_steals` per rank, rather than one
+ * per block.
+ *
+ * Construction and destruction are collective over the communicator.
+ */
+class WorkQueue {
+  public:
+    /**
+     * @brief Creates a work queue over the items `[0, count)`.
+     *
+     * @param comm The communicator to create the queue over
+     * @param count The total number of work items
+     * @param chunk The number of items handed out by each call to `next`
+     * @param max_failed_steals The number of exhausted blocks of other ranks to probe before giving
+     *  up, or 0 to never steal
+     */
+    template <typename From>
+    WorkQueue(trait::Deref<From, Comm> &comm,
+              std::int64_t count,
+              std::int64_t chunk = 1,
+              int max_failed_steals = default_max_failed_steals)
+        : rank_(comm.deref().rank()),
+          size_(comm.deref().size()),
+          count_(count),
+          chunk_(chunk),
+          max_failed_steals_(max_failed_steals),
+          victim_(rank_),
+          cursors_(comm, 0, size_) {
+        if (count < 0) {
+            throw std::out_of_range("WorkQueue: count must not be negative");
+        }
+
+        if (chunk < 1) {
+            throw std::out_of_range("WorkQueue: chunk must be positive");
+        }
+
+        if (max_failed_steals < 0) {
+            throw std::out_of_range("WorkQueue: max_failed_steals must not be negative");
+        }
+    }
+
+    static constexpr int default_max_failed_steals = 8;
+
+    /**
+     * @brief Claims the next chunk of work.
+     *
+     * @param range Receives the claimed items when successful
+     * @return True if work was claimed, false if every block has been exhausted.
+     */
+    bool next(WorkRange &range) {
+        while (visited_ < size_) {
+            if (visited_ > 0 && failed_steals_ >= max_failed_steals_) {
+                return false;
+            }
+
+            auto const block = block_of(victim_);
+            if (!block.empty()) {
+                auto const offset = cursors_.fetch_add(victim_, chunk_);
+                if (offset < block.size()) {
+                    range.first = block.first + offset;
+                    range.last = std::min(range.first + chunk_, block.last);
+                    return true;
+                }
+
+                if (victim_ != rank_) {
+                    failed_steals_++;
+                }
+            }
+
+            advance();
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief The block of items initially assigned to `rank`.
+     */
+    WorkRange block_of(rank_t rank) const {
+        auto const base = count_ / size_;
+        auto const extra = count_ % size_;
+
+        WorkRange r;
+        r.first = base * rank + std::min<std::int64_t>(rank, extra);
+        r.last = r.first + base + (rank < extra ? 1 : 0);
+        return r;
+    }
+
+    std::int64_t count() const { return count_; }
+    std::int64_t chunk() const { return chunk_; }
+
+    /**
+     * @brief The number of exhausted blocks of other ranks probed so far.
+     */
+    int failed_steals() const { return failed_steals_; }
+
+  private:
+    void advance() {
+        if (++visited_ == 1 && size_ > 1) {
+            // Leaving our own block: start stealing at a victim that differs between ranks, so the
+            // ranks that run out of work first don't all probe the same blocks.
+            std::minstd_rand random(static_cast<std::minstd_rand::result_type>(rank_) + 1);
+            auto const offset = std::uniform_int_distribution<rank_t>(1, size_ - 1)(random);
+            victim_ = (rank_ + offset) % size_;
+            return;
+        }
+
+        victim_ = (victim_ + 1) % size_;
+        if (victim_ == rank_) {
+            victim_ = (victim_ + 1) % size_;
+        }
+    }
+
+    rank_t rank_;
+    rank_t size_;
+    std::int64_t count_;
+    std::int64_t chunk_;
+    int max_failed_steals_;
+
+    // Our own block is visited first, then the others in order from a random one. An exhausted
+    // block can never be refilled, so it is never visited again.
+    rank_t victim_;
+    rank_t visited_ = 0;
+    int failed_steals_ = 0;
+
+    GlobalCounter<std::int64_t> cursors_;
+};
+} // namespace mpi
+
+#endif // MPI_WORK_QUEUE_HPP
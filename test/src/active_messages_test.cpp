@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include <mpi/mpi.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+struct Counts {
+    std::vector<std::int64_t> visits;
+    std::int64_t pings = 0;
+    std::int64_t replies = 0;
+};
+
+struct Visit {
+    Counts *counts;
+
+    void operator()(mpi::rank_t, std::int64_t vertex, double weight) const {
+        counts->visits.at(vertex)++;
+        ASSERT_EQ(0.5 * vertex, weight);
+    }
+};
+
+struct Ping {
+    mpi::ActiveMessages *messages;
+    Counts *counts;
+
+    void operator()(mpi::rank_t source, int remaining) const {
+        counts->pings++;
+        if (remaining > 0) {
+            // Bounce back to the sender from inside the handler.
+            messages->send_am<Ping>(source, remaining - 1);
+        }
+    }
+};
+
+struct Reply {
+    Counts *counts;
+
+    void operator()(mpi::rank_t) const { counts->replies++; }
+};
+
+struct Request {
+    mpi::ActiveMessages *messages;
+
+    void operator()(mpi::rank_t source, int replies) const {
+        // Many batches to one peer from inside a handler, while that peer may already have
+        // finished the drain round.
+        for (int i = 0; i < replies; i++) {
+            messages->send_am<Reply>(source);
+        }
+    }
+};
+
+struct Unregistered {
+    void operator()(mpi::rank_t) const {}
+};
+} // namespace
+
+TEST(ActiveMessages, Dispatch) {
+    auto world = mpi::Comm::world();
+
+    auto const size = world.size();
+    auto const rank = world.rank();
+
+    mpi::ActiveMessages am(world, 256);
+    Counts counts;
+
+    ASSERT_EQ(0, am.register_handler(Visit{&counts}));
+    ASSERT_EQ(1, am.register_handler(Ping{&am, &counts}));
+    ASSERT_THROW(am.register_handler(Ping{&am, &counts}), std::logic_error);
+    ASSERT_THROW(am.send_am<Unregistered>(0), std::logic_error);
+
+    constexpr int vertices = 100;
+    counts.visits.assign(vertices, 0);
+
+    for (mpi::rank_t dest = 0; dest < size; dest++) {
+        for (int v = 0; v < vertices; v++) {
+            am.send_am<Visit>(dest, v, 0.5 * v);
+        }
+        am.progress();
+    }
+    am.send_am<Ping>((rank + 1) % size, 3);
+    am.drain();
+
+    for (auto visits : counts.visits) {
+        ASSERT_EQ(size, visits);
+    }
+    ASSERT_EQ(std::int64_t(4) * size, world.all_reduce(mpi::sum(), counts.pings));
+}
+
+TEST(ActiveMessages, FanOutDuringDrain) {
+    auto world = mpi::Comm::world();
+
+    // Batches of a single reply, so each handler sends many batches to the same peer.
+    mpi::ActiveMessages am(world, 2);
+    Counts counts;
+    am.register_handler(Reply{&counts});
+    am.register_handler(Request{&am});
+
+    constexpr int replies = 50;
+    if (world.rank() != 0) {
+        am.send_am<Request>(0, replies);
+    }
+    am.drain();
+
+    ASSERT_EQ(world.rank() == 0 ? 0 : replies, counts.replies);
+}
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <mpi/mpi.hpp>
+
+#include <cstdint>
+
+namespace {
+struct Hop {
+    mpi::rank_t origin;
+    std::int32_t remaining;
+};
+} // namespace
+
+TEST(Aggregator, ForwardAndDrain) {
+    auto world = mpi::Comm::world();
+
+    auto const size = world.size();
+    auto const rank = world.rank();
+
+    constexpr int items = 1000;
+    constexpr int hops = 3;
+
+    std::int64_t handled = 0;
+    std::int64_t origin_sum = 0;
+
+    // Each item is forwarded around the ring, including from inside the handler during drain.
+    std::unique_ptr<mpi::Aggregator<Hop>> aggregator;
+    aggregator = std::make_unique<mpi::Aggregator<Hop>>(
+        world,
+        [&](mpi::rank_t source, Hop const &hop) {
+            ASSERT_EQ((rank + size - 1) % size, source);
+            handled++;
+            if (hop.remaining > 0) {
+                aggregator->send((rank + 1) % size, Hop{hop.origin, hop.remaining - 1});
+            } else {
+                origin_sum += hop.origin;
+            }
+        },
+        64);
+
+    for (int i = 0; i < items; i++) {
+        aggregator->send((rank + 1) % size, Hop{rank, hops - 1});
+        if (i % 100 == 0) {
+            aggregator->progress();
+        }
+    }
+    aggregator->drain();
+
+    ASSERT_EQ(std::int64_t(items) * hops * size, world.all_reduce(mpi::sum(), handled));
+
+    // Every item ends `hops` ranks after its origin.
+    ASSERT_EQ(std::int64_t(items) * ((rank + size - hops % size) % size), origin_sum);
+
+    // A second step after a drain starts from a clean slate.
+    handled = 0;
+    aggregator->send((rank + 1) % size, Hop{rank, 0});
+    aggregator->drain();
+    ASSERT_EQ(1, handled);
+}
+
+TEST(Aggregator, FanOutDuringDrain) {
+    auto world = mpi::Comm::world();
+
+    auto const size = world.size();
+    auto const rank = world.rank();
+
+    constexpr int replies = 50;
+
+    std::int64_t handled = 0;
+
+    // Rank 0 answers each request with many tiny batches, all sent from inside the handler while
+    // the requesters may already have finished the drain round.
+    std::unique_ptr<mpi::Aggregator<Hop>> aggregator;
+    aggregator = std::make_unique<mpi::Aggregator<Hop>>(
+        world,
+        [&](mpi::rank_t source, Hop const &hop) {
+            handled++;
+            for (int i = 0; i < hop.remaining; i++) {
+                aggregator->send(source, Hop{rank, 0});
+            }
+        },
+        2);
+
+    if (rank != 0) {
+        aggregator->send(0, Hop{rank, replies});
+    }
+    aggregator->drain();
+
+    ASSERT_EQ(rank == 0 ? size - 1 : replies, handled);
+}
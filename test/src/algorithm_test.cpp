@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <mpi/mpi.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+TEST(Algorithm, SampleSort) {
+    auto world = mpi::Comm::world();
+
+    // Uneven sizes, with duplicates and an empty rank.
+    std::mt19937 rng(world.rank());
+    std::uniform_int_distribution<int> values(0, 50);
+    std::vector<int> data(world.rank() == 1 ? 0 : 100 * (world.rank() + 1));
+    for (auto &value : data) {
+        value = values(rng);
+    }
+
+    auto const expected_total = world.all_reduce(mpi::sum(), static_cast<int>(data.size()));
+    auto const expected_sum =
+        world.all_reduce(mpi::sum(), std::accumulate(data.begin(), data.end(), 0));
+
+    mpi::sort(world, data, std::greater<int>());
+
+    ASSERT_TRUE(std::is_sorted(data.begin(), data.end(), std::greater<int>()));
+    ASSERT_EQ(expected_total, world.all_reduce(mpi::sum(), static_cast<int>(data.size())));
+    ASSERT_EQ(expected_sum,
+              world.all_reduce(mpi::sum(), std::accumulate(data.begin(), data.end(), 0)));
+
+    // Every element is ordered after those of the lower ranks.
+    auto const last = data.empty() ? std::numeric_limits<int>::max() : data.back();
+    auto const lasts = world.all_gather(last);
+    for (int r = 0; r < world.rank(); r++) {
+        if (!data.empty()) {
+            ASSERT_GE(lasts[r], data.front());
+        }
+    }
+}
+
+TEST(Algorithm, SampleSortFewKeys) {
+    auto world = mpi::Comm::world();
+
+    // Only two distinct keys, so most elements are equal to a splitter.
+    std::vector<int> data(1000);
+    for (std::size_t i = 0; i < data.size(); i++) {
+        data[i] = (i + world.rank()) % 2;
+    }
+
+    mpi::sort(world, data);
+    ASSERT_TRUE(std::is_sorted(data.begin(), data.end()));
+
+    // Runs of equal keys are split evenly, rather than landing on one process each.
+    auto const total = std::int64_t(1000) * world.size();
+    std::int64_t const count = data.size();
+    auto const most = world.all_reduce(mpi::max(), count);
+    ASSERT_LE(most, total / world.size() * 3 / 2);
+    ASSERT_EQ(total, world.all_reduce(mpi::sum(), count));
+}
+
+TEST(Algorithm, DistributedHistogram) {
+    auto world = mpi::Comm::world();
+
+    // Rank r contributes r + 1 copies of each of 0.5, 1.5, ..., 9.5, plus values out of range.
+    std::vector<double> data;
+    for (int copy = 0; copy <= world.rank(); copy++) {
+        for (int i = 0; i < 10; i++) {
+            data.push_back(i + 0.5);
+        }
+    }
+    data.push_back(-1.0);
+    data.push_back(10.0);
+    data.push_back(std::numeric_limits<double>::quiet_NaN());
+
+    auto const histogram = mpi::distributed_histogram(world, data, 5, 0.0, 10.0);
+
+    auto const copies = world.size() * (world.size() + 1) / 2;
+    ASSERT_EQ(std::vector<std::uint64_t>(5, 2 * copies), histogram);
+
+    ASSERT_THROW(mpi::distributed_histogram(world, data, 0, 0.0, 10.0), std::out_of_range);
+    ASSERT_THROW(mpi::distributed_histogram(world, data, 5, 1.0, 1.0), std::out_of_range);
+}
+
+TEST(Algorithm, DistributedTopK) {
+    auto world = mpi::Comm::world();
+
+    // Rank r holds r, r + size, r + 2 size, ... below 100, so every value below 100 is somewhere.
+    std::vector<int> data;
+    for (int value = world.rank(); value < 100; value += world.size()) {
+        data.push_back(value);
+    }
+
+    auto const top = mpi::distributed_top_k(world, data, 5);
+    ASSERT_EQ((std::vector<int>{99, 98, 97, 96, 95}), top);
+
+    auto const bottom =
+        mpi::distributed_top_k(world, nonstd::span<int const>(data), 3, std::greater<int>());
+    ASSERT_EQ((std::vector<int>{0, 1, 2}), bottom);
+
+    // Fewer elements than k in total.
+    std::vector<int> const one{world.rank()};
+    auto const all = mpi::distributed_top_k(world, nonstd::span<int const>(one), 100);
+    ASSERT_EQ(static_cast<std::size_t>(world.size()), all.size());
+    ASSERT_EQ(world.size() - 1, all.front());
+}
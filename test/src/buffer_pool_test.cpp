@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include <mpi/mpi.hpp>
+
+#include <memory>
+#include <vector>
+
+TEST(BufferPool, Reuse) {
+    auto pool = std::make_shared<mpi::BufferPool>();
+
+    int const *first;
+    {
+        mpi::PooledBuffer<int> buffer(pool, 10);
+        ASSERT_EQ(10u, buffer.size());
+        first = buffer.data();
+    }
+
+    // A request in the same size class gets the released buffer back.
+    mpi::PooledBuffer<int> reused(pool, 12);
+    ASSERT_EQ(first, reused.data());
+
+    // A buffer in use is never handed out twice.
+    mpi::PooledBuffer<int> other(pool, 12);
+    ASSERT_NE(reused.data(), other.data());
+
+    mpi::PooledBuffer<int> moved(std::move(other));
+    ASSERT_TRUE(other.empty());
+    ASSERT_EQ(12u, moved.size());
+}
+
+TEST(BufferPool, Cap) {
+    // Room for one 256 byte buffer on the free lists, but not two.
+    auto pool = std::make_shared<mpi::BufferPool>(false, 300);
+
+    {
+        mpi::PooledBuffer<char> a(pool, 256);
+        mpi::PooledBuffer<char> b(pool, 256);
+    }
+    ASSERT_EQ(256u, pool->cached_bytes());
+
+    {
+        mpi::PooledBuffer<char> big(pool, 1024);
+    }
+    ASSERT_EQ(256u, pool->cached_bytes());
+
+    pool->trim();
+    ASSERT_EQ(0u, pool->cached_bytes());
+}
+
+TEST(BufferPool, MpiAllocMem) {
+    auto pool = std::make_shared<mpi::BufferPool>(true);
+    mpi::PooledBuffer<double> buffer(pool, 1000);
+    for (std::size_t i = 0; i < buffer.size(); i++) {
+        buffer[i] = i;
+    }
+    ASSERT_EQ(999.0, buffer[999]);
+}
+
+TEST(BufferPool, PooledCollectives) {
+    auto world = mpi::Comm::world();
+    auto const pool = world.buffer_pool();
+    ASSERT_EQ(pool, world.buffer_pool());
+
+    auto const dup = world.dup();
+    ASSERT_EQ(pool, dup.deref().buffer_pool());
+
+    for (int iteration = 0; iteration < 3; iteration++) {
+        auto const gathered = world.all_gather_pooled(world.rank() * 2);
+        ASSERT_EQ(static_cast<std::size_t>(world.size()), gathered.size());
+        for (int i = 0; i < world.size(); i++) {
+            ASSERT_EQ(i * 2, gathered[i]);
+        }
+
+        std::vector<int> send(world.size());
+        for (int i = 0; i < world.size(); i++) {
+            send[i] = world.rank() * world.size() + i;
+        }
+        auto const received = world.all_to_all_pooled(send);
+        for (int i = 0; i < world.size(); i++) {
+            ASSERT_EQ(i * world.size() + world.rank(), received[i]);
+        }
+
+        if (world.rank() == 0) {
+            auto const ranks = world.gather_into_root_pooled(0, world.rank());
+            for (int i = 0; i < world.size(); i++) {
+                ASSERT_EQ(i, ranks[i]);
+            }
+        } else {
+            world.gather(0, world.rank());
+        }
+    }
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <mpi/mpi.hpp>
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+// Rank r writes r + 1 elements, so every rank's part has a different size.
+std::vector<double> part(mpi::rank_t rank) {
+    std::vector<double> values;
+    for (int i = 0; i <= rank; i++) {
+        values.push_back(rank * 100 + i);
+    }
+    return values;
+}
+
+// A path in the temporary directory that no other run uses, agreed on by every process.
+std::string unique_path(mpi::Comm comm, std::string const &name) {
+    std::int64_t const id = comm.broadcast(0, static_cast<std::int64_t>(getpid()));
+    return testing::TempDir() + name + "_" + std::to_string(id);
+}
+
+std::vector<double> whole(mpi::rank_t ranks) {
+    std::vector<double> values;
+    for (mpi::rank_t r = 0; r < ranks; r++) {
+        auto const p = part(r);
+        values.insert(values.end(), p.begin(), p.end());
+    }
+    return values;
+}
+} // namespace
+
+TEST(Checkpoint, WriteRestart) {
+    auto world = mpi::Comm::world();
+    auto const path = unique_path(world, "mpi_cpp_checkpoint_test");
+
+    mpi::CheckpointOptions options;
+    options.files = 2;
+    options.aggregators_per_node = 2;
+
+    for (int step = 0; step < 2; step++) {
+        mpi::CheckpointWriter writer(world, path, options);
+        writer.write("values", part(world.rank()));
+        writer.write("rank", std::vector<std::int32_t>{world.rank() + step});
+        ASSERT_THROW(writer.write("rank", std::vector<std::int32_t>{0}), std::logic_error);
+        writer.commit();
+    }
+
+    // Restart on the same number of processes gets back what each wrote.
+    {
+        mpi::CheckpointReader reader(world, path);
+        ASSERT_EQ(world.size(), reader.saved_ranks());
+        ASSERT_EQ((std::vector<std::string>{"values", "rank"}), reader.datasets());
+        ASSERT_EQ(part(world.rank()), reader.read<double>("values"));
+        ASSERT_EQ(std::vector<std::int32_t>{world.rank() + 1}, reader.read<std::int32_t>("rank"));
+        ASSERT_THROW(reader.read<float>("values"), std::logic_error);
+        ASSERT_THROW(reader.read<double>("missing"), std::out_of_range);
+    }
+
+    // Restart on fewer processes redistributes the dataset evenly.
+    auto fewer = world.split(world.rank() < world.size() - 1 ? 0 : MPI_UNDEFINED);
+    if (fewer) {
+        mpi::CheckpointReader reader(fewer, path);
+        auto const expected = whole(world.size());
+        ASSERT_EQ(expected.size(), reader.global_size("values"));
+
+        auto const mine = reader.read<double>("values");
+        std::uint64_t const count = mine.size();
+        ASSERT_EQ(expected.size(), fewer.all_reduce(mpi::sum(), count));
+
+        auto const first = expected.begin() + fewer.exclusive_scan(mpi::sum(), count);
+        ASSERT_EQ(std::vector<double>(first, first + count), mine);
+
+        ASSERT_EQ(std::vector<double>(expected.begin() + 1, expected.begin() + 4),
+                  reader.read<double>("values", 1, 3));
+    }
+
+    world.barrier();
+    if (world.rank() == 0) {
+        mpi::UniqueFile::delete_file(path);
+        mpi::UniqueFile::delete_file(path + ".0");
+        mpi::UniqueFile::delete_file(path + ".1");
+    }
+}
+
+TEST(Checkpoint, GatherInSteps) {
+    auto world = mpi::Comm::world();
+    auto const path = unique_path(world, "mpi_cpp_checkpoint_steps_test");
+
+    // Steps smaller than an element, so parts are split mid-element across several gathers.
+    mpi::CheckpointOptions options;
+    options.gather_bytes = 20;
+
+    {
+        mpi::CheckpointWriter writer(world, path, options);
+        writer.write("values", part(world.rank()));
+        writer.write("empty", std::vector<double>());
+        writer.commit();
+    }
+
+    {
+        mpi::CheckpointReader reader(world, path);
+        ASSERT_EQ(part(world.rank()), reader.read<double>("values"));
+        ASSERT_EQ(0, reader.global_size("empty"));
+    }
+
+    world.barrier();
+    if (world.rank() == 0) {
+        mpi::UniqueFile::delete_file(path);
+        mpi::UniqueFile::delete_file(path + ".0");
+    }
+}
+
+TEST(Checkpoint, UncreatableDataFiles) {
+    auto world = mpi::Comm::world();
+    auto const path = unique_path(world, "mpi_cpp_missing_directory") + "/checkpoint";
+
+    mpi::CheckpointOptions options;
+    options.aggregators_per_node = 2;
+
+    // Only the aggregators try to create the files, but every process must throw.
+    ASSERT_THROW(mpi::CheckpointWriter(world, path, options), std::runtime_error);
+}
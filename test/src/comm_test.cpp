@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 #include <mpi/mpi.hpp>
 
+#include <algorithm>
+#include <map>
+#include <thread>
+
 TEST(Comm, Dup) {
     auto world = mpi::Comm::world();
 
@@ -30,4 +34,321 @@ TEST(Comm, RangeIncl) {
             ASSERT_LT(world.rank(), world.size() / 2 + 1);
         }
     }
-}
\ No newline at end of file
+}
+
+TEST(Comm, ThreadCommPool) {
+    auto world = mpi::Comm::world();
+
+    mpi::ThreadCommPool pool(world, 4);
+    ASSERT_EQ(4, pool.size());
+
+    auto const next = (world.rank() + 1) % world.size();
+    auto const prev = (world.rank() + world.size() - 1) % world.size();
+
+    auto exchange = [&](std::size_t thread) {
+        auto comm = pool[thread];
+        EXPECT_EQ(world.size(), comm.size());
+
+        int const send = world.rank() * 10 + static_cast<int>(thread);
+        int recv = -1;
+        auto request = comm.immediate_send(send, next);
+        comm.recv(recv, prev);
+        request.wait();
+        EXPECT_EQ(prev * 10 + static_cast<int>(thread), recv);
+    };
+
+    if (mpi::query_thread() == mpi::ThreadLevel::Multiple) {
+        std::vector<std::thread> threads;
+        for (std::size_t thread = 0; thread < pool.size(); thread++) {
+            threads.emplace_back(exchange, thread);
+        }
+        for (auto &t : threads) {
+            t.join();
+        }
+    } else {
+        for (std::size_t thread = 0; thread < pool.size(); thread++) {
+            exchange(thread);
+        }
+    }
+}
+
+TEST(Comm, CartHaloExchange) {
+    auto world = mpi::Comm::world();
+
+    // A ring along the first dimension, so the two neighbors in it are distinct on 3+ processes,
+    // and a non-periodic second dimension of size 1, so both neighbors in it are MPI_PROC_NULL.
+    auto const dims = mpi::dims_create(world.size(), {0, 1});
+    ASSERT_EQ(world.size(), dims[0]);
+
+    auto cart = world.cart_create(dims, {true, false});
+    ASSERT_EQ(2, cart.cart_ndims());
+    ASSERT_EQ(cart.rank(), cart.cart_rank(cart.cart_coords()));
+
+    auto const counts = cart.neighbor_counts();
+    ASSERT_EQ(4, counts.sources);
+    ASSERT_EQ(4, counts.destinations);
+    ASSERT_THROW(world.neighbor_counts(), std::logic_error);
+
+    std::vector<mpi::rank_t> neighbors;
+    for (int d = 0; d < 2; d++) {
+        auto const shift = cart.cart_shift(d);
+        neighbors.push_back(shift.source);
+        neighbors.push_back(shift.dest);
+    }
+
+    // Each process sends its rank to every neighbor.
+    auto const gathered = cart.neighbor_all_gather(cart.rank());
+    for (int i = 0; i < 4; i++) {
+        if (neighbors[i] != MPI_PROC_NULL) {
+            ASSERT_EQ(neighbors[i], gathered[i]);
+        }
+    }
+
+    // Block i goes to neighbor i, and arrives in the opposite block of that neighbor.
+    std::vector<int> send(8);
+    for (int i = 0; i < 8; i++) {
+        send[i] = cart.rank() * 100 + i;
+    }
+
+    std::vector<int> recv(8, -1);
+    cart.neighbor_all_to_all<int>(send, recv);
+
+    std::vector<int> irecv(8, -1);
+    cart.immediate_neighbor_all_to_all<int>(send, irecv).wait();
+    ASSERT_EQ(recv, irecv);
+
+    for (int i = 0; i < 4; i++) {
+        auto const opposite = i ^ 1;
+        for (int j = 0; j < 2; j++) {
+            if (neighbors[i] == MPI_PROC_NULL) {
+                ASSERT_EQ(-1, recv[2 * i + j]);
+            } else {
+                ASSERT_EQ(neighbors[i] * 100 + 2 * opposite + j, recv[2 * i + j]);
+            }
+        }
+    }
+
+    // Send i + 1 elements to neighbor i.
+    std::vector<int> send_counts{1, 2, 3, 4};
+    std::vector<int> send_displs{0, 1, 3, 6};
+    std::vector<int> vsend(10, cart.rank());
+
+    std::vector<int> recv_counts{2, 1, 4, 3};
+    std::vector<int> recv_displs{0, 2, 3, 7};
+    std::vector<int> vrecv(10, -1);
+
+    cart.neighbor_all_to_all_v<int>(
+        vsend, send_counts, send_displs, vrecv, recv_counts, recv_displs);
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < recv_counts[i]; j++) {
+            auto const expected = neighbors[i] == MPI_PROC_NULL ? -1 : neighbors[i];
+            ASSERT_EQ(expected, vrecv[recv_displs[i] + j]);
+        }
+    }
+}
+
+TEST(Comm, DistGraphNeighborAllToAllV) {
+    auto world = mpi::Comm::world();
+
+    auto const size = world.size();
+    auto const rank = world.rank();
+
+    std::vector<mpi::rank_t> sources{(rank + size - 1) % size, (rank + size - 2) % size};
+    std::vector<mpi::rank_t> destinations{(rank + 1) % size, (rank + 2) % size};
+
+    auto graph = world.dist_graph_create_adjacent(sources, {2, 1}, destinations, {2, 1});
+
+    auto const &neighbors = graph.dist_graph_neighbors();
+    ASSERT_EQ(&neighbors, &graph.dist_graph_neighbors());
+    ASSERT_EQ(2, neighbors.sources.size());
+    ASSERT_EQ(2, neighbors.destinations.size());
+    ASSERT_EQ(2, neighbors.source_weights.size());
+
+    auto const counts = graph.neighbor_counts();
+    ASSERT_EQ(2, counts.sources);
+    ASSERT_EQ(2, counts.destinations);
+
+    // Each process sends a different number of copies of its rank to each neighbor.
+    std::vector<std::vector<int>> send(neighbors.destinations.size());
+    for (std::size_t i = 0; i < send.size(); i++) {
+        send[i].assign(graph.rank() % 3 + i, graph.rank());
+    }
+
+    auto const recv = graph.neighbor_all_to_all_v(send);
+    ASSERT_EQ(neighbors.sources.size(), recv.size());
+    for (std::size_t i = 0; i < recv.size(); i++) {
+        auto const source = neighbors.sources[i];
+        for (auto value : recv[i]) {
+            ASSERT_EQ(source, value);
+        }
+    }
+
+    // The cache is copied along with the communicator.
+    auto duped = graph.dup();
+    ASSERT_EQ(neighbors.sources, duped.dist_graph_neighbors().sources);
+    ASSERT_EQ(2, duped.neighbor_counts().destinations);
+}
+
+TEST(Comm, SparseAllToAll) {
+    auto world = mpi::Comm::world();
+
+    auto const size = world.size();
+    auto const rank = world.rank();
+
+    for (int round = 0; round < 4; round++) {
+        // Only even ranks send, each to the next `round` ranks, so odd ranks never send and some
+        // ranks never receive.
+        std::map<mpi::rank_t, std::vector<int>> send;
+        if (rank % 2 == 0) {
+            for (int i = 1; i <= round; i++) {
+                send[(rank + i) % size].assign(i - 1, rank);
+            }
+        }
+
+        auto const received = world.sparse_all_to_all(send, 10 + round % 2);
+
+        std::map<mpi::rank_t, std::vector<int>> expected;
+        for (mpi::rank_t source = 0; source < size; source += 2) {
+            for (int i = 1; i <= round; i++) {
+                if ((source + i) % size == rank) {
+                    expected[source].assign(i - 1, source);
+                }
+            }
+        }
+        ASSERT_EQ(expected, received);
+    }
+}
+
+TEST(Comm, Split) {
+    auto world = mpi::Comm::world();
+
+    auto const color = world.rank() % 2;
+    auto half = world.split(color, -world.rank());
+    ASSERT_EQ((world.size() + 1 - color) / 2, half.size());
+
+    // Keys are negated ranks, so the order is reversed.
+    auto const ranks = half.all_gather(world.rank());
+    ASSERT_TRUE(std::is_sorted(ranks.rbegin(), ranks.rend()));
+
+    auto none = world.split(MPI_UNDEFINED);
+    ASSERT_FALSE(none);
+
+    auto node = world.split_type();
+    ASSERT_GE(node.size(), 1);
+}
+
+TEST(Comm, SplitCached) {
+    auto world = mpi::Comm::world();
+    auto parent = world.dup();
+
+    auto const first = parent.split_cached(parent.rank() % 2);
+    auto const again = parent.split_cached(parent.rank() % 2);
+    ASSERT_EQ(first.get_raw(), again.get_raw());
+
+    // Only some of the processes have their arguments cached, so all of them must create a new
+    // communicator.
+    auto const mixed = parent.split_cached(parent.rank() == 0 ? 0 : 1);
+    ASSERT_EQ(parent.rank() == 0 ? 1 : parent.size() - 1, mixed.size());
+
+    // The replaced communicator remains usable.
+    ASSERT_EQ((parent.size() + 1 - parent.rank() % 2) / 2, first.size());
+
+    auto const node = parent.split_type_cached();
+    ASSERT_EQ(node.get_raw(), parent.split_type_cached().get_raw());
+}
+
+TEST(Comm, SplitCachedDifferentGroups) {
+    auto world = mpi::Comm::world();
+    auto parent = world.dup();
+
+    // Every process finds its own color in the cache on the third call, but from different
+    // earlier calls, so the cached communicators do not have the requested groups.
+    auto const half = parent.rank() < parent.size() / 2;
+    parent.split_cached(half ? 0 : 1);
+    parent.split_cached(half ? 1 : 0);
+    auto const parity = parent.split_cached(parent.rank() % 2);
+
+    ASSERT_EQ((parent.size() + 1 - parent.rank() % 2) / 2, parity.size());
+    ASSERT_EQ(parent.rank() / 2, parity.rank());
+}
+
+TEST(Comm, CreateGroup) {
+    auto world = mpi::Comm::world();
+
+    // Only the even processes take part.
+    if (world.rank() % 2 == 0) {
+        mpi::GroupRange range(0, world.size() - 1, 2);
+        auto evens = world.create_group(world.group().range_incl(range));
+        ASSERT_EQ((world.size() + 1) / 2, evens.size());
+        ASSERT_EQ(world.rank() / 2, evens.rank());
+    }
+}
+
+TEST(Comm, TagAllocator) {
+    auto world = mpi::Comm::world();
+    auto comm = world.dup();
+
+    auto &allocator = comm.tag_allocator();
+    ASSERT_EQ(&allocator, &comm.tag_allocator());
+    ASSERT_EQ(comm.tag_ub(), allocator.tag_ub());
+
+    auto const a = allocator.allocate(10);
+    auto const b = allocator.allocate(5);
+    ASSERT_EQ(comm.tag_ub(), a.last());
+    ASSERT_EQ(a.first - 1, b.last());
+
+    // Each component exchanges on its own tags over the shared communicator.
+    auto const next = (comm.rank() + 1) % comm.size();
+    auto const prev = (comm.rank() + comm.size() - 1) % comm.size();
+    auto send_b = comm.immediate_send(comm.rank() * 2, next, b[0]);
+    auto send_a = comm.immediate_send(comm.rank(), next, a[0]);
+    int from_a, from_b;
+    comm.recv(from_a, prev, a[0]);
+    comm.recv(from_b, prev, b[0]);
+    send_a.wait();
+    send_b.wait();
+    ASSERT_EQ(prev, from_a);
+    ASSERT_EQ(prev * 2, from_b);
+
+    // Released ranges are reused and merged.
+    auto const before = allocator.available();
+    allocator.release(a);
+    auto const c = allocator.allocate(4);
+    ASSERT_EQ(a.first, c.first);
+    allocator.release(c);
+    allocator.release(b);
+    ASSERT_EQ(before + a.count + b.count, allocator.available());
+    ASSERT_EQ(comm.tag_ub(), allocator.allocate(15).last());
+
+    ASSERT_THROW(allocator.allocate(comm.tag_ub() + 1), std::out_of_range);
+
+    // The smallest tags are never handed out.
+    auto const rest = allocator.allocate(static_cast<mpi::tag_t>(allocator.available()));
+    mpi::tag_t const reserved = mpi::TagAllocator::reserved_tags;
+    ASSERT_EQ(reserved, rest.first);
+    ASSERT_THROW(allocator.allocate(1), std::out_of_range);
+
+    // A duplicate has a fresh tag space.
+    auto duped = comm.dup();
+    ASSERT_NE(&allocator, &duped.tag_allocator());
+    ASSERT_EQ(comm.tag_ub(), duped.tag_allocator().allocate(1).first);
+}
+
+TEST(Comm, AllToAllV) {
+    auto world = mpi::Comm::world();
+
+    // Rank r sends r + 1 copies of its rank to every rank.
+    std::vector<int> send(world.size() * (world.rank() + 1), world.rank());
+    std::vector<int> const send_counts(world.size(), world.rank() + 1);
+
+    std::vector<int> recv_counts;
+    auto const recv = world.all_to_all_v(
+        nonstd::span<int const>(send), nonstd::span<int const>(send_counts), &recv_counts);
+
+    std::vector<int> expected;
+    for (int r = 0; r < world.size(); r++) {
+        ASSERT_EQ(r + 1, recv_counts[r]);
+        expected.insert(expected.end(), r + 1, r);
+    }
+    ASSERT_EQ(expected, recv);
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <mpi/mpi.hpp>
+
+#ifdef MPI_CPP_HAS_COROUTINES
+
+using namespace mpi;
+
+namespace {
+Task ring_exchange(Comm world, int round, std::vector<int> &received) {
+    auto const next = (world.rank() + 1) % world.size();
+    auto const prev = (world.rank() + world.size() - 1) % world.size();
+
+    int const value = world.rank() * 1000 + round;
+    int recv = -1;
+
+    auto recv_request = world.immediate_recv(recv, prev, round);
+    co_await world.immediate_send(value, next, round);
+    auto const status = co_await std::move(recv_request);
+
+    EXPECT_EQ(prev, status.source());
+    received[round] = recv;
+}
+
+Task never_matched(Comm world) {
+    int recv = -1;
+    co_await world.immediate_recv(recv, world.rank(), 1000000);
+}
+
+Task fail() {
+    throw std::runtime_error("task failed");
+    co_return;
+}
+} // namespace
+
+TEST(Coroutine, ManyTasks) {
+    auto world = Comm::world();
+    auto const prev = (world.rank() + world.size() - 1) % world.size();
+
+    constexpr int rounds = 1000;
+    std::vector<int> received(rounds, -1);
+
+    Scheduler scheduler;
+    for (int round = 0; round < rounds; round++) {
+        scheduler.spawn(ring_exchange(world, round, received));
+    }
+
+    EXPECT_EQ(rounds, scheduler.live());
+    scheduler.run();
+    EXPECT_EQ(0, scheduler.live());
+
+    for (int round = 0; round < rounds; round++) {
+        EXPECT_EQ(prev * 1000 + round, received[round]);
+    }
+}
+
+TEST(Coroutine, FailedTaskCancelsRequests) {
+    auto world = Comm::world();
+
+    {
+        Scheduler scheduler;
+        scheduler.spawn(never_matched(world));
+        scheduler.spawn(fail());
+        EXPECT_THROW(scheduler.run(), std::runtime_error);
+
+        // Destroying the scheduler cancels the receive that can never complete.
+    }
+}
+
+#endif // MPI_CPP_HAS_COROUTINES
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <mpi/mpi.hpp>
+
+#include <numeric>
+#include <vector>
+
+TEST(File, WriteReadAt) {
+    auto world = mpi::Comm::world();
+    auto const filename = "mpi_cpp_file_test.dat";
+    auto const block = 16;
+
+    std::vector<int> values(block);
+    std::iota(values.begin(), values.end(), world.rank() * block);
+
+    {
+        auto file = mpi::UniqueFile::open(
+            world, filename, mpi::FileMode::Create | mpi::FileMode::ReadWrite);
+        file.set_view<int>(0);
+
+#ifdef MPI_CPP_HAS_NONBLOCKING_COLLECTIVE_IO
+        file.iwrite_at_all(world.rank() * block, nonstd::span<int const>(values)).wait();
+#else
+        file.write_at_all(world.rank() * block, nonstd::span<int const>(values));
+#endif
+        file.sync();
+        ASSERT_EQ(static_cast<mpi::offset_t>(world.size() * block * sizeof(int)), file.size());
+
+        // Read the block of the next rank back, both collectively and independently.
+        auto const next = (world.rank() + 1) % world.size();
+        std::vector<int> collective(block);
+        file.read_at_all(next * block, nonstd::span<int>(collective));
+
+        std::vector<int> independent(block);
+        file.iread_at(next * block, nonstd::span<int>(independent)).wait();
+
+        for (int i = 0; i < block; i++) {
+            ASSERT_EQ(next * block + i, collective[i]);
+            ASSERT_EQ(next * block + i, independent[i]);
+        }
+    }
+
+    world.barrier();
+    if (world.rank() == 0) {
+        mpi::UniqueFile::delete_file(filename);
+    }
+}
+
+TEST(File, NoncontiguousView) {
+    auto world = mpi::Comm::world();
+    auto const filename = "mpi_cpp_file_view_test.dat";
+    auto const count = 8;
+
+    // Element i of rank r goes to position i * size + r, so the ranks' elements are interleaved.
+    std::vector<int> values(count);
+    for (int i = 0; i < count; i++) {
+        values[i] = i * world.size() + world.rank();
+    }
+
+    {
+        auto file = mpi::UniqueFile::open(
+            world, filename, mpi::FileMode::Create | mpi::FileMode::ReadWrite);
+
+        auto const filetype = mpi::UniqueDatatype::strided(count, 1, world.size(), MPI_INT);
+        file.set_view<int>(world.rank() * sizeof(int), filetype);
+        file.write_at_all(0, nonstd::span<int const>(values));
+        file.sync();
+
+        file.set_view<int>(0);
+        std::vector<int> all(count * world.size());
+        file.read_at_all(0, nonstd::span<int>(all));
+        for (std::size_t i = 0; i < all.size(); i++) {
+            ASSERT_EQ(static_cast<int>(i), all[i]);
+        }
+    }
+
+    world.barrier();
+    if (world.rank() == 0) {
+        mpi::UniqueFile::delete_file(filename);
+    }
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <mpi/mpi.hpp>
+
+#include <vector>
+
+TEST(Group, SetOperations) {
+    auto world = mpi::Comm::world();
+    auto group = world.group();
+    auto const size = group.size();
+
+    ASSERT_EQ(world.size(), size);
+    ASSERT_EQ(world.rank(), group.rank());
+
+    std::vector<mpi::rank_t> evens;
+    for (mpi::rank_t r = 0; r < size; r += 2) {
+        evens.push_back(r);
+    }
+
+    auto even = group.incl(evens);
+    auto odd = group.excl(evens);
+    ASSERT_EQ(static_cast<mpi::rank_t>(evens.size()), even.size());
+    ASSERT_EQ(size - even.size(), odd.size());
+    ASSERT_EQ(world.rank() % 2 == 0 ? world.rank() / 2 : MPI_UNDEFINED, even.rank());
+
+    ASSERT_EQ(0, even.intersection(odd).size());
+    ASSERT_EQ(mpi::GroupComparison::Identical, even.difference(odd).compare(even));
+
+    // The union lists the even ranks first, which is only the original order on 1 or 2 ranks.
+    auto const reordered =
+        size > 2 ? mpi::GroupComparison::Similar : mpi::GroupComparison::Identical;
+    ASSERT_EQ(reordered, even.union_with(odd).compare(group));
+
+    auto const evens_only =
+        size > 1 ? mpi::GroupComparison::Unequal : mpi::GroupComparison::Identical;
+    ASSERT_EQ(evens_only, even.compare(group));
+}
+
+TEST(Group, TranslateRanks) {
+    auto world = mpi::Comm::world();
+    auto group = world.group();
+
+    std::vector<mpi::rank_t> reversed;
+    for (mpi::rank_t r = group.size() - 1; r >= 0; r--) {
+        reversed.push_back(r);
+    }
+    auto backwards = group.incl(reversed);
+
+    auto const table = backwards.translate_ranks(group);
+    ASSERT_EQ(static_cast<std::size_t>(group.size()), table.size());
+    for (mpi::rank_t r = 0; r < group.size(); r++) {
+        ASSERT_EQ(group.size() - 1 - r, table[r]);
+    }
+
+    std::vector<mpi::rank_t> const first{0};
+    auto const head = group.incl(first);
+    auto const to_head = group.translate_ranks(head);
+    ASSERT_EQ(0, to_head.at(0));
+    for (mpi::rank_t r = 1; r < group.size(); r++) {
+        ASSERT_EQ(MPI_UNDEFINED, to_head[r]);
+    }
+    ASSERT_THROW(to_head.at(group.size()), std::out_of_range);
+}
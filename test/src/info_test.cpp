@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include <mpi/mpi.hpp>
+
+TEST(Info, SetGetErase) {
+    auto info = mpi::UniqueInfo::create();
+    ASSERT_EQ(0, info.nkeys());
+    ASSERT_FALSE(info.get("cb_nodes"));
+
+    info.set("cb_nodes", "4");
+    ASSERT_EQ(1, info.nkeys());
+    ASSERT_EQ("cb_nodes", info.nth_key(0));
+    ASSERT_EQ(std::string("4"), *info.get("cb_nodes"));
+
+    auto const copy = info.dup();
+    ASSERT_TRUE(info.erase("cb_nodes"));
+    ASSERT_FALSE(info.erase("cb_nodes"));
+    ASSERT_EQ(0, info.nkeys());
+    ASSERT_EQ(std::string("4"), *copy.get("cb_nodes"));
+
+    mpi::Info const null;
+    ASSERT_EQ(0, null.nkeys());
+    ASSERT_FALSE(null.get("cb_nodes"));
+}
+
+TEST(Info, Builder) {
+    auto world = mpi::Comm::world();
+
+    auto const win_info =
+        mpi::InfoBuilder().no_locks().accumulate_ordering("none").same_size().build();
+    ASSERT_EQ(std::string("true"), *win_info.get("no_locks"));
+    ASSERT_EQ(std::string("none"), *win_info.get("accumulate_ordering"));
+
+    auto win = mpi::UniqueWin<int>::allocate(world, 4, win_info);
+    ASSERT_TRUE(win);
+
+    auto const comm_info = mpi::InfoBuilder().no_any_source().no_any_tag().build();
+    auto comm = world.dup(comm_info);
+    ASSERT_EQ(world.size(), comm.size());
+    ASSERT_TRUE(comm.get_info());
+
+    auto const file_info = mpi::InfoBuilder().cb_nodes(2).striping_factor(4).build();
+    ASSERT_EQ(std::string("2"), *file_info.get("cb_nodes"));
+    ASSERT_EQ(std::string("4"), *file_info.get("striping_factor"));
+
+    auto *const memory = mpi::alloc_mem(1024, file_info);
+    mpi::free_mem(memory);
+}
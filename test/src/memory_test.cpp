@@ -0,0 +1,21 @@
+#include <gtest/gtest.h>
+#include <mpi/mpi.hpp>
+
+#include <numeric>
+
+TEST(Memory, AllocatorVector) {
+    auto world = mpi::Comm::world();
+
+    mpi::vector<int> send(world.size());
+    std::iota(send.begin(), send.end(), world.rank() * world.size());
+
+    mpi::vector<int> recv(world.size());
+    world.all_to_all(send, recv);
+    for (int i = 0; i < world.size(); i++) {
+        ASSERT_EQ(i * world.size() + world.rank(), recv[i]);
+    }
+
+    // Growing the vector reallocates through MPI_Alloc_mem.
+    send.resize(1 << 16, 7);
+    ASSERT_EQ(7, send.back());
+}
@@ -74,4 +74,70 @@ TEST(RMA, LockUnlock) {
     win.unlock_all();
 
     ASSERT_EQ(comm.size(), sum);
-}
\ No newline at end of file
+}
+
+TEST(RMA, FetchAndOp) {
+    auto comm = Comm::world();
+
+    auto win = UniqueWin<std::int64_t>::allocate(comm, comm.rank() == 0 ? 1 : 0);
+    if (comm.rank() == 0) {
+        win[0] = 0;
+    }
+
+    win.lock_all();
+    comm.barrier();
+
+    auto const previous = win.fetch_and_op(mpi::sum(), std::int64_t{1}, 0, 0);
+    EXPECT_LE(0, previous);
+    EXPECT_GT(comm.size(), previous);
+
+    comm.barrier();
+
+    EXPECT_EQ(comm.size(), win.fetch_and_op(mpi::no_op(), std::int64_t{0}, 0, 0));
+    win.unlock_all();
+}
+
+TEST(RMA, GlobalCounter) {
+    auto comm = Comm::world();
+
+    for (rank_t shards = 1; shards <= comm.size(); shards++) {
+        mpi::GlobalCounter<> counter(comm, 0, shards);
+
+        for (int i = 0; i < 10; i++) {
+            counter.fetch_add();
+        }
+
+        comm.barrier();
+
+        EXPECT_EQ(10 * comm.size(), counter.sum());
+
+        comm.barrier();
+    }
+}
+
+TEST(RMA, WorkQueue) {
+    auto comm = Comm::world();
+
+    std::int64_t const count = 1000;
+    int const default_steals = mpi::WorkQueue::default_max_failed_steals;
+
+    // Owners always empty their own blocks, so every item is claimed however soon stealing stops.
+    for (int max_failed_steals : {default_steals, 1, 0}) {
+        mpi::WorkQueue queue(comm, count, 7, max_failed_steals);
+
+        std::int64_t claimed = 0;
+        std::int64_t checksum = 0;
+        mpi::WorkRange range;
+        while (queue.next(range)) {
+            ASSERT_FALSE(range.empty());
+            claimed += range.size();
+            for (auto i = range.first; i < range.last; i++) {
+                checksum += i;
+            }
+        }
+
+        EXPECT_LE(queue.failed_steals(), max_failed_steals);
+        EXPECT_EQ(count, comm.all_reduce(mpi::sum(), claimed));
+        EXPECT_EQ(count * (count - 1) / 2, comm.all_reduce(mpi::sum(), checksum));
+    }
+}
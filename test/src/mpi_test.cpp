@@ -146,6 +146,73 @@ TEST(Immediate, CollectiveWait) {
     send_request.wait();
 }
 
+TEST(Immediate, TestSome) {
+    auto world = mpi::Comm::world();
+
+    auto const rank = world.rank();
+    auto send_request = world.immediate_send(rank, 0);
+
+    if (world.rank() == 0) {
+        std::vector<int> ranks(world.size(), -1);
+
+        std::vector<mpi::UniqueRequest> requests;
+        requests.reserve(world.size());
+
+        for (auto i = 0; i < world.size(); i++) {
+            requests.push_back(world.immediate_recv(ranks[i], i));
+        }
+
+        std::vector<int> completed;
+        while (mpi::any_active(requests)) {
+            mpi::test_some_into(requests, completed);
+        }
+
+        EXPECT_EQ(world.size(), completed.size());
+        EXPECT_TRUE(mpi::test_all(requests));
+
+        for (auto i = 0; i < world.size(); i++) {
+            EXPECT_EQ(i, ranks[i]);
+        }
+    }
+
+    while (!send_request.test()) {
+    }
+}
+
+TEST(Immediate, TestAny) {
+    auto world = mpi::Comm::world();
+
+    auto const rank = world.rank();
+
+    // Post the receives first, so the sends can complete without being buffered.
+    std::vector<int> received(world.size(), -1);
+    std::vector<mpi::UniqueRequest> receives;
+    if (rank == 0) {
+        for (auto i = 0; i < world.size(); i++) {
+            receives.push_back(world.immediate_recv(received[i], i));
+        }
+    }
+
+    std::vector<mpi::UniqueRequest> requests;
+    requests.push_back(world.immediate_send(rank, 0));
+
+    int index;
+    mpi::Status status;
+    while (!mpi::test_any(requests, index, status)) {
+    }
+    EXPECT_EQ(0, index);
+
+    if (rank == 0) {
+        mpi::wait_all(receives);
+        for (auto i = 0; i < world.size(); i++) {
+            EXPECT_EQ(i, received[i]);
+        }
+    }
+
+    EXPECT_TRUE(mpi::test_any(requests, index));
+    EXPECT_EQ(MPI_UNDEFINED, index);
+}
+
 TEST(KeyVal, Rank) {
     auto rank_key_val = mpi::Comm::create_keyval<rank_t>();
 
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <mpi/mpi.hpp>
+
+#include <thread>
+
+using namespace mpi;
+
+TEST(Partitioned, Ring) {
+    auto world = Comm::world();
+
+    auto const next = (world.rank() + 1) % world.size();
+    auto const prev = (world.rank() + world.size() - 1) % world.size();
+
+    constexpr int partitions = 8;
+    constexpr int partition_size = 16;
+
+    std::vector<int> send(partitions * partition_size);
+    std::vector<int> recv(send.size(), -1);
+
+    auto sender = world.partitioned_send<int>(send, partitions, next, 100);
+    auto receiver = world.partitioned_recv<int>(recv, partitions, prev, 100);
+
+    for (int round = 0; round < 2; round++) {
+        receiver.start();
+        sender.start();
+
+        auto produce = [&](int p) {
+            for (int i = 0; i < partition_size; i++) {
+                send[p * partition_size + i] = world.rank() * 1000 + round * 100 + p;
+            }
+            sender.ready(p);
+        };
+
+        if (query_thread() == ThreadLevel::Multiple) {
+            std::vector<std::thread> producers;
+            for (int p = 0; p < partitions; p++) {
+                producers.emplace_back(produce, p);
+            }
+            for (auto &t : producers) {
+                t.join();
+            }
+        } else {
+            for (int p = partitions - 1; p >= 0; p--) {
+                produce(p);
+            }
+        }
+
+        std::vector<bool> consumed(partitions, false);
+        int remaining = partitions;
+        while (remaining > 0) {
+            for (int p = 0; p < partitions; p++) {
+                if (!consumed[p] && receiver.arrived(p)) {
+                    for (auto value : receiver.partition(p)) {
+                        ASSERT_EQ(prev * 1000 + round * 100 + p, value);
+                    }
+                    consumed[p] = true;
+                    remaining--;
+                }
+            }
+        }
+
+        receiver.wait();
+        sender.wait();
+    }
+}
@@ -0,0 +1,244 @@
+#include <gtest/gtest.h>
+#include <mpi/mpi.hpp>
+
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+
+using namespace mpi;
+
+TEST(RequestSet, Callbacks) {
+    auto world = Comm::world();
+
+    auto const rank = world.rank();
+    std::vector<int> received(world.size(), -1);
+    std::vector<int> sources;
+
+    RequestSet requests;
+    for (rank_t i = 0; i < world.size(); i++) {
+        requests.add(world.immediate_recv(received[i], i),
+                     [&sources, i](Status const &status) {
+                         EXPECT_EQ(i, status.source());
+                         sources.push_back(i);
+                     });
+    }
+
+    for (rank_t i = 0; i < world.size(); i++) {
+        requests.add(world.immediate_send(rank, i));
+    }
+
+    EXPECT_EQ(2 * world.size(), requests.size());
+
+    while (!requests.empty()) {
+        requests.test_some();
+    }
+
+    EXPECT_EQ(world.size(), sources.size());
+    for (rank_t i = 0; i < world.size(); i++) {
+        EXPECT_EQ(i, received[i]);
+    }
+}
+
+TEST(RequestSet, Continuation) {
+    auto world = Comm::world();
+
+    auto const next = (world.rank() + 1) % world.size();
+    auto const prev = (world.rank() + world.size() - 1) % world.size();
+
+    // Pass a token around the ring twice, with each hop posted from the previous hop's callback.
+    // Every send has its own buffer, since an earlier send may still be active.
+    int received = -1;
+    int token = -1;
+    int hops = 0;
+    std::vector<int> sent(3, -1);
+
+    RequestSet requests;
+    std::function<void(Status const &)> forward = [&](Status const &) {
+        hops++;
+        token = received + 1;
+        if (hops < 2) {
+            requests.add(world.immediate_recv(received, prev), forward);
+        }
+        if (!(world.rank() == 0 && hops == 2)) {
+            sent[hops] = token;
+            requests.add(world.immediate_send(sent[hops], next));
+        }
+    };
+
+    if (world.rank() == 0) {
+        sent[0] = 0;
+        requests.add(world.immediate_send(sent[0], next));
+    }
+    requests.add(world.immediate_recv(received, prev), forward);
+
+    requests.wait_all();
+
+    EXPECT_EQ(2, hops);
+    EXPECT_EQ(world.size() * (2 - (world.rank() == 0 ? 0 : 1)) + world.rank(), token);
+}
+
+TEST(RequestSet, ThrowingCallback) {
+    auto world = Comm::world();
+
+    // The messages are sent to this process before the receives are posted, so the receives
+    // usually complete together, and the callbacks after the throwing one must still run.
+    std::vector<int> const sent{0, 1, 2};
+    std::vector<UniqueRequest> sends;
+    for (auto const &value : sent) {
+        sends.push_back(world.immediate_send(value, world.rank()));
+    }
+
+    std::vector<int> received(sent.size(), -1);
+    int calls = 0;
+    RequestSet requests;
+    for (std::size_t i = 0; i < received.size(); i++) {
+        requests.add(world.immediate_recv(received[i], world.rank()), [&, i](Status const &) {
+            calls++;
+            if (i == 0) {
+                throw std::runtime_error("callback failed");
+            }
+        });
+    }
+
+    int errors = 0;
+    while (!requests.empty()) {
+        try {
+            requests.wait_some();
+        } catch (std::runtime_error const &) {
+            errors++;
+        }
+    }
+    mpi::wait_all(sends);
+
+    EXPECT_EQ(3, calls);
+    EXPECT_EQ(1, errors);
+    EXPECT_EQ(sent, received);
+}
+
+TEST(ProgressEngine, Futures) {
+    if (query_thread() != ThreadLevel::Multiple) {
+        GTEST_SKIP() << "MPI was not initialized with MPI_THREAD_MULTIPLE";
+    }
+
+    auto world = Comm::world();
+    auto const next = (world.rank() + 1) % world.size();
+    auto const prev = (world.rank() + world.size() - 1) % world.size();
+
+    std::vector<int> const send(1 << 16, world.rank());
+    std::vector<int> recv(send.size(), -1);
+
+    ProgressEngine engine;
+    auto received = engine.submit(world.immediate_recv(recv.data(), recv.size(), prev));
+    engine.submit(world.immediate_send(send.data(), send.size(), next), [](Status const &) {});
+
+    EXPECT_EQ(prev, received.get().source());
+
+    engine.wait_idle();
+    EXPECT_EQ(0, engine.outstanding());
+
+    for (auto value : recv) {
+        ASSERT_EQ(prev, value);
+    }
+}
+
+TEST(ProgressEngine, CallbackError) {
+    if (query_thread() != ThreadLevel::Multiple) {
+        GTEST_SKIP() << "MPI was not initialized with MPI_THREAD_MULTIPLE";
+    }
+
+    auto world = Comm::world();
+    auto const rank = world.rank();
+
+    int unmatched = -1;
+    int send = rank;
+    int recv = -1;
+
+    ProgressEngine engine;
+
+    // Nothing is ever sent on this tag, so only cancelling it lets the engine shut down.
+    auto never = engine.submit(world.immediate_recv(unmatched, rank, 1));
+
+    engine.submit(world.immediate_recv(recv, rank), [](Status const &) {
+        throw std::runtime_error("callback failed");
+    });
+    engine.submit(world.immediate_send(send, rank), [](Status const &) {});
+
+    EXPECT_THROW(engine.wait_idle(), std::runtime_error);
+    EXPECT_THROW(never.get(), std::runtime_error);
+
+    // Requests submitted after the failure are abandoned too.
+    auto late = engine.submit(world.immediate_recv(unmatched, rank, 2));
+    EXPECT_THROW(late.get(), std::runtime_error);
+}
+
+TEST(Future, Pipeline) {
+    auto world = Comm::world();
+
+    auto const next = (world.rank() + 1) % world.size();
+    auto const prev = (world.rank() + world.size() - 1) % world.size();
+
+    auto sent = world.async_send(world.rank(), next);
+
+    // Receive from the previous rank, then sum the received values, then pass the sum on.
+    auto result = world.async_recv<int>(prev)
+                      .then([&](int received) {
+                          EXPECT_EQ(prev, received);
+                          return world.async_all_reduce(sum(), received);
+                      })
+                      .then([&](int total) {
+                          EXPECT_EQ(world.size() * (world.size() - 1) / 2, total);
+                          return world.async_send(std::vector<int>(3, total), next, 1);
+                      });
+
+    auto forwarded = world.async_recv_vector<int>(3, prev, 1);
+
+    while (!result.test()) {
+    }
+    result.get();
+
+    EXPECT_EQ(std::vector<int>(3, world.size() * (world.size() - 1) / 2), forwarded.get());
+    sent.get();
+}
+
+TEST(Future, WhenAll) {
+    auto world = Comm::world();
+
+    std::vector<Future<std::vector<int>>> gathers;
+    for (int i = 0; i < 3; i++) {
+        gathers.push_back(world.async_all_gather(world.rank() + i));
+    }
+
+    auto all = when_all(std::move(gathers)).get();
+    ASSERT_EQ(3, all.size());
+    for (int i = 0; i < 3; i++) {
+        for (rank_t r = 0; r < world.size(); r++) {
+            EXPECT_EQ(r + i, all[i][r]);
+        }
+    }
+
+    auto both = when_all(world.async_all_reduce(max(), world.rank()),
+                         world.async_barrier().then([] { return 42; }))
+                    .get();
+    EXPECT_EQ(world.size() - 1, std::get<0>(both));
+    EXPECT_EQ(42, std::get<1>(both));
+
+    auto mixed = when_all(world.async_barrier(), world.async_all_reduce(sum(), 1)).get();
+    static_assert(std::is_same<VoidResult, std::tuple_element_t<0, decltype(mixed)>>::value,
+                  "void results are mapped to VoidResult");
+    EXPECT_EQ(world.size(), std::get<1>(mixed));
+}
+
+TEST(Future, DroppedWhilePending) {
+    auto world = Comm::world();
+
+    auto const next = (world.rank() + 1) % world.size();
+    auto const prev = (world.rank() + world.size() - 1) % world.size();
+
+    {
+        // Dropping a pending future waits for completion instead of aborting.
+        auto sent = world.async_send(std::vector<int>(1024, world.rank()), next);
+        auto received = world.async_recv_vector<int>(1024, prev);
+    }
+
+    EXPECT_EQ(42, make_ready_future(42).then([](int v) { return make_ready_future(v); }).get());
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <mpi/mpi.hpp>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+struct Point {
+    double x;
+    double y;
+};
+
+using Record = std::map<std::string, std::vector<std::pair<std::int32_t, std::string>>>;
+
+Record make_record(int rank) {
+    Record record;
+    record["rank"] = {{rank, std::to_string(rank)}};
+    record["empty"] = {};
+    for (int i = 0; i < rank; i++) {
+        record["items"].emplace_back(i, std::string(i, 'a' + i));
+    }
+    return record;
+}
+} // namespace
+
+TEST(Serialize, RoundTrip) {
+    std::vector<std::string> const strings{"", "a", "hello world"};
+    ASSERT_EQ(strings, mpi::deserialize<std::vector<std::string>>(mpi::serialize(strings)));
+
+    auto const record = make_record(3);
+    auto const bytes = mpi::serialize(record);
+    ASSERT_EQ(mpi::serialized_size(record), bytes.size());
+    ASSERT_EQ(record, mpi::deserialize<Record>(bytes));
+
+    // Truncated and oversized inputs are rejected.
+    ASSERT_THROW(mpi::deserialize<Record>(nonstd::span<char const>(bytes.data(), bytes.size() - 1)),
+                 std::out_of_range);
+    auto padded = bytes;
+    padded.push_back(0);
+    ASSERT_THROW(mpi::deserialize<Record>(padded), std::out_of_range);
+
+    std::vector<bool> const flags{true, false, false, true, true};
+    ASSERT_EQ(flags, mpi::deserialize<std::vector<bool>>(mpi::serialize(flags)));
+}
+
+TEST(Serialize, Views) {
+    // A single char before the points forces padding, so the points are aligned for a view.
+    std::pair<char, std::vector<Point>> const value{'x', {{1, 2}, {3, 4}, {5, 6}}};
+    auto const bytes = mpi::serialize(value);
+
+    auto const view = mpi::deserialize<std::pair<char, nonstd::span<Point const>>>(bytes);
+    ASSERT_EQ('x', view.first);
+    ASSERT_EQ(3, view.second.size());
+    ASSERT_GE(view.second.data(), reinterpret_cast<Point const *>(bytes.data()));
+    ASSERT_EQ(5, view.second[2].x);
+
+    auto const text = mpi::deserialize<nonstd::span<char const>>(mpi::serialize(std::string("hi")));
+    ASSERT_EQ(2, text.size());
+}
+
+TEST(Serialize, SendRecv) {
+    auto world = mpi::Comm::world();
+
+    auto const next = (world.rank() + 1) % world.size();
+    auto const prev = (world.rank() + world.size() - 1) % world.size();
+
+    auto sent = world.async_send_serialized(make_record(world.rank()), next, 7);
+    ASSERT_EQ(make_record(prev), world.recv_serialized<Record>(prev, 7));
+    sent.get();
+
+    std::vector<int> const values(world.rank() + 1, world.rank());
+    auto request = world.immediate_send(values.data(), values.size(), next, 8);
+    mpi::Status status;
+    auto const received = world.recv_vector<int>(MPI_ANY_SOURCE, 8, &status);
+    request.wait();
+    ASSERT_EQ(prev, status.source());
+    ASSERT_EQ(std::vector<int>(prev + 1, prev), received);
+}
+
+TEST(Serialize, RecvVectorWrongSize) {
+    auto world = mpi::Comm::world();
+
+    auto const next = (world.rank() + 1) % world.size();
+    auto const prev = (world.rank() + world.size() - 1) % world.size();
+
+    // Three chars are not a whole number of ints; the message is still consumed, so the
+    // following one on the same tag is received.
+    char const odd[] = {'a', 'b', 'c'};
+    int const value = world.rank();
+    auto first = world.immediate_send(odd, 3, next, 9);
+    auto second = world.immediate_send(&value, 1, next, 9);
+    ASSERT_THROW(world.recv_vector<int>(prev, 9), std::logic_error);
+    ASSERT_EQ(std::vector<int>{prev}, world.recv_vector<int>(prev, 9));
+    first.wait();
+    second.wait();
+}
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include <mpi/mpi.hpp>
+
+#include <vector>
+
+TEST(StreamingWriter, Steps) {
+    auto world = mpi::Comm::world();
+    auto const path = "mpi_cpp_streaming_test.dat";
+    auto const steps = 5;
+
+    // Rank r writes r + 1 ints per step.
+    auto const count = world.rank() + 1;
+    auto const step_size = world.size() * (world.size() + 1) / 2;
+    {
+        mpi::StreamingWriter writer(world, path, 2);
+        std::vector<int> slab(count);
+        for (int step = 0; step < steps; step++) {
+            for (int i = 0; i < count; i++) {
+                slab[i] = step * 1000 + world.rank() * 10 + i;
+            }
+            writer.write_step(slab);
+            ASSERT_LE(writer.pending(), 2u);
+
+            // The slab may be overwritten straight away.
+            slab.assign(count, -1);
+            writer.progress();
+        }
+        ASSERT_EQ(static_cast<std::uint64_t>(steps * step_size * sizeof(int)), writer.size());
+
+        writer.close();
+        ASSERT_EQ(0u, writer.pending());
+        ASSERT_THROW(writer.write_step(slab), std::logic_error);
+    }
+
+    {
+        auto file = mpi::UniqueFile::open(world, path, mpi::FileMode::ReadOnly);
+        file.set_view<int>(0);
+        auto const first = world.rank() * (world.rank() + 1) / 2;
+        for (int step = 0; step < steps; step++) {
+            std::vector<int> slab(count);
+            file.read_at_all(step * step_size + first, nonstd::span<int>(slab));
+            for (int i = 0; i < count; i++) {
+                ASSERT_EQ(step * 1000 + world.rank() * 10 + i, slab[i]);
+            }
+        }
+    }
+
+    world.barrier();
+    if (world.rank() == 0) {
+        mpi::UniqueFile::delete_file(path);
+    }
+}